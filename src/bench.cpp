@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_incremental.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_tasks.h"
+
+template <typename F>
+double Seconds(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 1024;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : 64;
+  S21Matrix a(n, n);
+  std::mt19937 gen(21);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) a(i, j) = dist(gen);
+
+  std::printf("LU n=%d\n%8s %10s %10s %8s\n", n, "threads", "seconds",
+              "GFLOP/s", "speedup");
+  double base = 0;
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    S21Runtime::SetThreads(threads);
+    const double seconds = Seconds([&] { S21LU<double> lu(a); });
+    if (threads == 1) base = seconds;
+    std::printf("%8d %10.4f %10.2f %8.2f\n", threads, seconds,
+                2.0 * n * n * n / 3 / seconds * 1e-9, base / seconds);
+  }
+
+  S21Runtime::SetThreads(0);
+  S21Matrix spd(n, n);
+  S21Matrix::Gemm(1, a, false, a, true, 0, spd);
+  for (int i = 0; i < n; i++) spd(i, i) += n;
+  const double lu = Seconds([&] { S21LU<double> f(spd); });
+  const double chol = Seconds([&] { S21Cholesky<double> f(spd); });
+  std::printf("\nSPD n=%d: LU %.4f s, Cholesky %.4f s (%.2fx)\n", n, lu, chol,
+              lu / chol);
+
+  // Reproducible vs fast mode; the reductions are repeated to be measurable.
+  const struct {
+    const char* name;
+    int repeat;
+    double (*run)(const S21Matrix&);
+  } ops[] = {
+      {"MulMatrix", 1,
+       [](const S21Matrix& m) { return (S21Matrix(m) * m).Trace(); }},
+      {"Determinant", 1, [](const S21Matrix& m) { return m.Determinant(); }},
+      {"Dot", 20, [](const S21Matrix& m) { return m.Dot(m); }},
+      {"Frobenius", 20, [](const S21Matrix& m) { return m.Norm(); }},
+      {"ColSums", 20,
+       [](const S21Matrix& m) { return m.ColSums().Dot(m.ColSums()); }},
+  };
+  std::printf("\nn=%d, %d threads\n%12s %12s %12s %8s %10s\n", n,
+              S21Runtime::Threads(), "op", "reproducible", "fast", "cost",
+              "identical");
+  for (const auto& op : ops) {
+    double seconds[2], value[2];
+    for (S21Determinism mode :
+         {S21Determinism::kReproducible, S21Determinism::kFast}) {
+      S21DeterminismScope scope(mode);
+      const int k = static_cast<int>(mode);
+      seconds[k] = Seconds([&] {
+        for (int r = 0; r < op.repeat; r++) value[k] = op.run(a);
+      });
+    }
+    // Whether reproducible results survive a change of thread count.
+    S21Runtime::SetThreads(1);
+    const double serial = op.run(a);
+    S21Runtime::SetThreads(0);
+    std::printf("%12s %12.4f %12.4f %7.2fx %10s\n", op.name, seconds[0],
+                seconds[1], seconds[0] / seconds[1],
+                serial == value[0] ? "yes" : "no");
+  }
+
+  // Construction, then a thin product that writes every row band of C in
+  // parallel; new[]{} is the serial value-initialization it replaces.
+  S21Matrix thin_a(n, 8), thin_b(8, n);
+  volatile double sink = 0;
+  const double serial_fill = Seconds([&] {
+    double* raw = new double[static_cast<size_t>(n) * n]{};
+    sink = raw[static_cast<size_t>(n) * n - 1];
+    delete[] raw;
+  });
+  std::printf("\nconstruct n=%d (new[]{}: %.4f s)\n%14s %10s %10s\n", n,
+              serial_fill, "mode", "construct", "first pass");
+  for (bool zero : {true, false}) {
+    S21Matrix* c = nullptr;
+    const double construct = Seconds([&] {
+      c = zero ? new S21Matrix(n, n)
+               : new S21Matrix(n, n, S21Matrix::kUninitialized);
+    });
+    const double pass = Seconds(
+        [&] { S21Matrix::Gemm(1, thin_a, false, thin_b, false, 0, *c); });
+    std::printf("%14s %10.4f %10.4f\n", zero ? "zeroed" : "uninitialized",
+                construct, pass);
+    delete c;
+  }
+
+  // One rank-1 step: inverse and determinant from scratch, then updated.
+  S21IncrementalInverse<double> inc(spd);
+  S21Matrix u(n, 1), v(n, 1);
+  for (int i = 0; i < n; i++) u(i, 0) = dist(gen), v(i, 0) = dist(gen);
+  const double full =
+      Seconds([&] { sink = spd.InverseMatrix()(0, 0) + spd.Determinant(); });
+  const double step = Seconds([&] {
+    inc.Update(u, v);
+    sink = inc.Inverse()(0, 0) + inc.Determinant();
+  });
+  std::printf("\nrank-1 step n=%d: full %.4f s, update %.4f s (%.1fx)\n", n,
+              full, step, full / step);
+  return 0;
+}
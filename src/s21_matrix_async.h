@@ -0,0 +1,135 @@
+#ifndef S21_MATRIX_ASYNC_H_
+#define S21_MATRIX_ASYNC_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_tasks.h"
+
+class S21Async;
+
+// Shared result of an asynchronous operation; copies refer to the same
+// result. A plain value converts to a ready future, so values and pending
+// results can be mixed freely as inputs of further operations.
+template <typename R>
+class S21Future {
+ public:
+  S21Future() = default;
+  S21Future(R value) : state_(std::make_shared<State>()) {
+    state_->Set(std::move(value));
+  }
+
+  bool Valid() const noexcept { return state_ != nullptr; }
+  bool IsReady() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->ready;
+  }
+  void Wait() const {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->cv.wait(lock, [this] { return state_->ready; });
+  }
+  // Blocks until ready and rethrows the operation's exception, if any.
+  const R& Get() const {
+    Wait();
+    if (state_->error) std::rethrow_exception(state_->error);
+    return *state_->value;
+  }
+  // Runs f(Get()) on the scheduler once this result is ready.
+  template <typename F>
+  auto Then(F f) const;
+
+ private:
+  friend class S21Async;
+
+  struct State {
+    void Set(R result) {
+      Finish([&] { value.emplace(std::move(result)); });
+    }
+    void Fail(std::exception_ptr failure) {
+      Finish([&] { error = failure; });
+    }
+    // Runs fn now if the result is ready, otherwise once it is.
+    void OnReady(std::function<void()> fn) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ready) {
+          continuations.push_back(std::move(fn));
+          return;
+        }
+      }
+      fn();
+    }
+
+    template <typename Store>
+    void Finish(Store store) {
+      std::vector<std::function<void()>> next;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        store();
+        ready = true;
+        next.swap(continuations);
+      }
+      cv.notify_all();
+      for (auto& fn : next) fn();
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ready = false;
+    std::optional<R> value;
+    std::exception_ptr error;
+    std::vector<std::function<void()>> continuations;
+  };
+
+  explicit S21Future(std::shared_ptr<State> state)
+      : state_(std::move(state)) {}
+
+  std::shared_ptr<State> state_;
+};
+
+class S21Async {
+ public:
+  // Runs f(args.Get()...) on the scheduler once every argument is ready and
+  // returns its result as a future. Nothing blocks while waiting, so chains
+  // of calls form a DAG whose independent branches run concurrently. An
+  // exception from f or from any argument is stored in the result.
+  template <typename F, typename... R>
+  static auto When(F f, S21Future<R>... args) {
+    using Out = std::decay_t<std::invoke_result_t<F&, const R&...>>;
+    static_assert(!std::is_void_v<Out>, "The operation must return a value");
+    if (!(args.Valid() && ...))
+      throw std::logic_error("The future has no shared state");
+    auto state = std::make_shared<typename S21Future<Out>::State>();
+    auto pending = std::make_shared<std::atomic<int>>(sizeof...(R) + 1);
+    auto arrive = [=] {
+      if (pending->fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+      S21Scheduler::Post([=]() mutable {
+        try {
+          state->Set(f(args.Get()...));
+        } catch (...) {
+          state->Fail(std::current_exception());
+        }
+      });
+    };
+    (args.state_->OnReady(arrive), ...);
+    arrive();
+    return S21Future<Out>(state);
+  }
+};
+
+template <typename R>
+template <typename F>
+auto S21Future<R>::Then(F f) const {
+  return S21Async::When(std::move(f), *this);
+}
+
+#endif  // S21_MATRIX_ASYNC_H_
@@ -0,0 +1,132 @@
+#include "s21_matrix_cholesky.h"
+
+#include <vector>
+
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+template <typename T>
+S21Cholesky<T>::S21Cholesky(const S21BasicMatrix<T>& a) : l_(a) {
+  if (a.GetRows() != a.GetCols())
+    throw std::logic_error("The matrix must be square");
+  const int n = l_.rows_;
+  l_.SetLayout(S21Layout::kRowMajor);
+  l_.Detach();
+  const int block = S21Tuning::Get().factor_block;
+  const int tiles = (n + block - 1) / block;
+  std::vector<int> last(tiles, -1);
+  S21TaskGraph graph;
+  for (int k = 0; k < tiles; k++) {
+    const int k0 = k * block, k1 = std::min(n, k0 + block);
+    last[k] = graph.Add([=] { FactorPanel(k0, k1); }, {last[k]});
+    for (int j = k + 1; j < tiles; j++) {
+      const int j0 = j * block, j1 = std::min(n, j0 + block);
+      last[j] =
+          graph.Add([=] { UpdateTile(k0, k1, j0, j1); }, {last[k], last[j]});
+    }
+  }
+  graph.Run(tiles > 1 ? S21Runtime::Threads() : 1);
+
+  for (int i = 0; i < n; i++)
+    for (int j = i + 1; j < n; j++) l_.Rows()[i][j] = 0;
+}
+
+template <typename T>
+void S21Cholesky<T>::FactorPanel(int k0, int k1) {
+  const int n = l_.rows_;
+  auto m = l_.Rows();
+  for (int c = k0; c < k1; c++) {
+    T d = m[c][c];
+    for (int k = k0; k < c; k++) d -= m[c][k] * m[c][k];
+    if (!(d > 0))
+      throw std::logic_error("The matrix must be positive definite");
+    d = std::sqrt(d);
+    m[c][c] = d;
+    for (int i = c + 1; i < n; i++) {
+      T sum = m[i][c];
+      for (int k = k0; k < c; k++) sum -= m[i][k] * m[c][k];
+      m[i][c] = sum / d;
+    }
+  }
+}
+
+template <typename T>
+void S21Cholesky<T>::UpdateTile(int k0, int k1, int j0, int j1) {
+  const int n = l_.rows_;
+  auto m = l_.Rows();
+  for (int i = j0; i < n; i++) {
+    const T* li = m[i];
+    for (int j = j0; j < j1 && j <= i; j++) {
+      const T* lj = m[j];
+      T sum = 0;
+      for (int k = k0; k < k1; k++) sum += li[k] * lj[k];
+      m[i][j] -= sum;
+    }
+  }
+}
+
+template <typename T>
+T S21Cholesky<T>::Determinant() const noexcept {
+  T det = 1;
+  for (int i = 0; i < l_.rows_; i++) det *= l_.Rows()[i][i];
+  return det * det;
+}
+
+template <typename T>
+T S21Cholesky<T>::LogDeterminant() const noexcept {
+  T sum = 0;
+  for (int i = 0; i < l_.rows_; i++) sum += std::log(l_.Rows()[i][i]);
+  return 2 * sum;
+}
+
+template <typename T>
+void S21Cholesky<T>::SolveInPlace(S21BasicMatrix<T>& b) const {
+  const int n = l_.rows_;
+  if (b.GetRows() != n)
+    throw std::logic_error("The right-hand side must have as many rows as A");
+  b.SetLayout(S21Layout::kRowMajor);
+  b.Detach();
+  auto m = l_.Rows();
+  auto x = b.Rows();
+  const int block = S21Tuning::Get().factor_block;
+  S21TaskGraph graph;
+  for (int j0 = 0; j0 < b.cols_; j0 += block) {
+    const int j1 = std::min(b.cols_, j0 + block);
+    graph.Add([=] {
+      for (int i = 0; i < n; i++) {
+        for (int k = 0; k < i; k++)
+          for (int j = j0; j < j1; j++) x[i][j] -= m[i][k] * x[k][j];
+        for (int j = j0; j < j1; j++) x[i][j] /= m[i][i];
+      }
+      for (int i = n - 1; i >= 0; i--) {
+        for (int j = j0; j < j1; j++) x[i][j] /= m[i][i];
+        for (int k = 0; k < i; k++)
+          for (int j = j0; j < j1; j++) x[k][j] -= m[i][k] * x[i][j];
+      }
+    });
+  }
+  graph.Run(S21Runtime::Threads());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Cholesky<T>::Solve(const S21BasicMatrix<T>& b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Cholesky<T>::Inverse() const {
+  S21BasicMatrix<T> x = S21BasicMatrix<T>::Identity(l_.rows_);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Cholesky<T>::L() const {
+  return l_;
+}
+
+template class S21Cholesky<float>;
+template class S21Cholesky<double>;
+template class S21Cholesky<long double>;
@@ -0,0 +1,32 @@
+#ifndef S21_MATRIX_CHOLESKY_H_
+#define S21_MATRIX_CHOLESKY_H_
+
+#include "s21_matrix_oop.h"
+
+// A = L * L^T for a symmetric positive definite A. Only the lower triangle
+// of A is read.
+template <typename T>
+class S21Cholesky {
+ public:
+  explicit S21Cholesky(const S21BasicMatrix<T>& a);
+
+  T Determinant() const noexcept;
+  T LogDeterminant() const noexcept;
+  // A column-major b is switched to row-major first.
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+  S21BasicMatrix<T> L() const;
+
+ private:
+  void FactorPanel(int k0, int k1);
+  void UpdateTile(int k0, int k1, int j0, int j1);
+
+  S21BasicMatrix<T> l_;
+};
+
+extern template class S21Cholesky<float>;
+extern template class S21Cholesky<double>;
+extern template class S21Cholesky<long double>;
+
+#endif  // S21_MATRIX_CHOLESKY_H_
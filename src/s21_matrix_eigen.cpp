@@ -0,0 +1,541 @@
+#include "s21_matrix_eigen.h"
+
+#include <stdexcept>
+
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+namespace {
+
+constexpr int kBlock = 64;
+constexpr int kMaxIterations = 60;
+
+// Rows per parallel chunk for a kernel touching `width` elements per row.
+int RowGrain(int width) {
+  return std::max(1, S21Tuning::Get().parallel_grain / width);
+}
+
+// Number of eigenvalues below x of the tridiagonal matrix with diagonal d
+// and squared off-diagonal e2: the negative pivots of T - x I (Sturm).
+template <typename T>
+int SturmCount(const std::vector<T>& d, const std::vector<T>& e2, T x,
+               T pivmin) {
+  int count = 0;
+  T q = 1;
+  for (size_t i = 0; i < d.size(); i++) {
+    q = d[i] - x - (i > 0 ? e2[i - 1] / q : 0);
+    if (std::abs(q) < pivmin) q = -pivmin;
+    if (q < 0) count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+template <typename T>
+S21SymmetricEigen<T>::S21SymmetricEigen(const S21BasicMatrix<T>& a,
+                                        bool vectors)
+    : S21SymmetricEigen(a, vectors, true) {}
+
+template <typename T>
+S21SymmetricEigen<T>::S21SymmetricEigen(const S21BasicMatrix<T>& a,
+                                        bool vectors, bool diagonalize)
+    : a_(a),
+      v_(vectors ? a.GetRows() : 1, vectors ? a.GetRows() : 1),
+      d_(a.GetRows()),
+      e_(a.GetRows()),
+      tau_(a.GetRows()),
+      vectors_(vectors) {
+  if (a.GetRows() != a.GetCols())
+    throw std::logic_error("The matrix must be square");
+  const int n = a_.rows_;
+  a_.SetLayout(S21Layout::kRowMajor);
+  a_.Detach();
+  auto m = a_.Rows();
+  for (int i = 0; i < n; i++)
+    for (int j = i + 1; j < n; j++) m[i][j] = m[j][i];
+  Tridiagonalize();
+  if (vectors_) AccumulateQ();
+  if (diagonalize) Diagonalize();
+}
+
+// Lower Householder reduction: the k-th reflector zeroes column k below the
+// subdiagonal and is stored there with an implicit unit first element.
+template <typename T>
+void S21SymmetricEigen<T>::Tridiagonalize() {
+  const int n = a_.rows_;
+  auto a = a_.Rows();
+  std::vector<T> v(n), w(n);
+  for (int k = 0; k + 2 < n; k++) {
+    d_[k] = a[k][k];
+    e_[k] = a[k + 1][k];
+    T sigma = 0;
+    for (int i = k + 2; i < n; i++) sigma += a[i][k] * a[i][k];
+    if (sigma == 0) continue;
+    const T x0 = a[k + 1][k];
+    const T norm = std::sqrt(x0 * x0 + sigma);
+    const T beta = x0 > 0 ? -norm : norm;
+    const T tau = (beta - x0) / beta;
+    tau_[k] = tau;
+    e_[k] = beta;
+    v[k + 1] = 1;
+    for (int i = k + 2; i < n; i++) v[i] = a[i][k] /= x0 - beta;
+
+    // A22 -= v * w^T + w * v^T with w = p - (tau / 2) (p . v) v and
+    // p = tau * A22 * v.
+    const int grain = RowGrain(n - k - 1);
+    S21ParallelFor(k + 1, n, grain, [&](int i0, int i1) {
+      for (int i = i0; i < i1; i++) {
+        T sum = 0;
+        for (int j = k + 1; j < n; j++) sum += a[i][j] * v[j];
+        w[i] = tau * sum;
+      }
+    });
+    T pv = 0;
+    for (int i = k + 1; i < n; i++) pv += w[i] * v[i];
+    for (int i = k + 1; i < n; i++) w[i] -= tau * pv / 2 * v[i];
+    S21ParallelFor(k + 1, n, grain, [&](int i0, int i1) {
+      for (int i = i0; i < i1; i++)
+        for (int j = k + 1; j < n; j++) a[i][j] -= v[i] * w[j] + w[i] * v[j];
+    });
+  }
+  if (n > 1) {
+    d_[n - 2] = a[n - 2][n - 2];
+    e_[n - 2] = a[n - 1][n - 2];
+  }
+  d_[n - 1] = a[n - 1][n - 1];
+  e_[n - 1] = 0;
+}
+
+// Q = H_0 * ... * H_{n-3}; column blocks of Q are independent.
+template <typename T>
+void S21SymmetricEigen<T>::AccumulateQ() {
+  const int n = a_.rows_;
+  auto a = a_.Rows();
+  auto q = v_.Rows();
+  for (int i = 0; i < n; i++) q[i][i] = 1;
+  S21ParallelFor(0, n, kBlock, [&](int j0, int j1) {
+    std::vector<T> w(j1 - j0);
+    for (int k = n - 3; k >= 0; k--) {
+      if (tau_[k] == 0) continue;
+      for (int j = j0; j < j1; j++) w[j - j0] = q[k + 1][j];
+      for (int i = k + 2; i < n; i++)
+        for (int j = j0; j < j1; j++) w[j - j0] += a[i][k] * q[i][j];
+      for (int j = j0; j < j1; j++) q[k + 1][j] -= tau_[k] * w[j - j0];
+      for (int i = k + 2; i < n; i++) {
+        const T tv = tau_[k] * a[i][k];
+        for (int j = j0; j < j1; j++) q[i][j] -= tv * w[j - j0];
+      }
+    }
+  });
+}
+
+// Implicit QL with Wilkinson shifts. The rotations of each sweep are
+// recorded and then applied to the rows of V in parallel.
+template <typename T>
+void S21SymmetricEigen<T>::Diagonalize() {
+  const int n = a_.rows_;
+  const T eps = std::numeric_limits<T>::epsilon();
+  std::vector<T> cs(n), sn(n);
+  auto v = v_.Rows();
+  T f = 0, tst1 = 0;
+  for (int l = 0; l < n; l++) {
+    tst1 = std::max(tst1, std::abs(d_[l]) + std::abs(e_[l]));
+    int m = l;
+    while (m < n - 1 && std::abs(e_[m]) > eps * tst1) m++;
+    for (int iter = 0; m > l && std::abs(e_[l]) > eps * tst1; iter++) {
+      if (iter == kMaxIterations)
+        throw std::runtime_error("The eigenvalue iteration did not converge");
+      T g = d_[l];
+      T p = (d_[l + 1] - g) / (2 * e_[l]);
+      T r = std::hypot(p, T(1));
+      if (p < 0) r = -r;
+      d_[l] = e_[l] / (p + r);
+      d_[l + 1] = e_[l] * (p + r);
+      const T dl1 = d_[l + 1];
+      T h = g - d_[l];
+      for (int i = l + 2; i < n; i++) d_[i] -= h;
+      f += h;
+
+      p = d_[m];
+      T c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+      const T el1 = e_[l + 1];
+      for (int i = m - 1; i >= l; i--) {
+        c3 = c2;
+        c2 = c;
+        s2 = s;
+        g = c * e_[i];
+        h = c * p;
+        r = std::hypot(p, e_[i]);
+        e_[i + 1] = s * r;
+        s = e_[i] / r;
+        c = p / r;
+        p = c * d_[i] - s * g;
+        d_[i + 1] = h + s * (c * g + s * d_[i]);
+        cs[i] = c;
+        sn[i] = s;
+      }
+      p = -s * s2 * c3 * el1 * e_[l] / dl1;
+      e_[l] = s * p;
+      d_[l] = c * p;
+
+      if (!vectors_) continue;
+      S21ParallelFor(0, n, RowGrain(m - l), [&](int k0, int k1) {
+        for (int k = k0; k < k1; k++) {
+          T* row = v[k];
+          for (int i = m - 1; i >= l; i--) {
+            const T t = row[i + 1];
+            row[i + 1] = sn[i] * row[i] + cs[i] * t;
+            row[i] = cs[i] * row[i] - sn[i] * t;
+          }
+        }
+      });
+    }
+    d_[l] += f;
+    e_[l] = 0;
+  }
+
+  for (int i = 0; i + 1 < n; i++) {
+    int k = i;
+    for (int j = i + 1; j < n; j++)
+      if (d_[j] < d_[k]) k = j;
+    if (k == i) continue;
+    std::swap(d_[i], d_[k]);
+    if (vectors_)
+      for (int j = 0; j < n; j++) std::swap(v[j][i], v[j][k]);
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SymmetricEigen<T>::Values() const {
+  const int n = a_.rows_;
+  S21BasicMatrix<T> res(n, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < n; i++) res.Rows()[i][0] = d_[i];
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SymmetricEigen<T>::Vectors() const {
+  if (!vectors_) throw std::logic_error("Eigenvectors were not computed");
+  return v_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SymmetricEigen<T>::Largest(const S21BasicMatrix<T>& a,
+                                                int k) {
+  if (k < 1 || k > a.GetRows()) throw std::out_of_range("Out of range");
+  const S21SymmetricEigen<T> eigen(a, false, false);
+  const std::vector<T>& d = eigen.d_;
+  const std::vector<T>& e = eigen.e_;
+  const int n = a.GetRows();
+  const T eps = std::numeric_limits<T>::epsilon();
+  std::vector<T> e2(n);
+  T lo = d[0], hi = d[0], emax = 0;
+  for (int i = 0; i < n; i++) {
+    e2[i] = e[i] * e[i];
+    const T radius = std::abs(e[i]) + (i > 0 ? std::abs(e[i - 1]) : 0);
+    lo = std::min(lo, d[i] - radius);
+    hi = std::max(hi, d[i] + radius);
+    emax = std::max(emax, e2[i]);
+  }
+  const T pivmin = std::numeric_limits<T>::min() * std::max(T(1), emax);
+  // The Gershgorin interval holds the whole spectrum. Each eigenvalue,
+  // largest first, is bisected below the bound left by the previous one.
+  S21BasicMatrix<T> res(k, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < k; i++) {
+    const int index = n - 1 - i;
+    T left = lo, right = hi;
+    while (true) {
+      const T mid = left + (right - left) / 2;
+      const T tol = 2 * eps * std::max(std::abs(left), std::abs(right));
+      if (right - left <= tol + pivmin || mid <= left || mid >= right) break;
+      if (SturmCount(d, e2, mid, pivmin) > index)
+        right = mid;
+      else
+        left = mid;
+    }
+    res.Rows()[i][0] = left + (right - left) / 2;
+    hi = right;
+  }
+  return res;
+}
+
+template <typename T>
+S21Eigen<T>::S21Eigen(const S21BasicMatrix<T>& a)
+    : h_(a), z_(a.GetRows(), a.GetRows()), re_(a.GetRows()), im_(a.GetRows()) {
+  if (a.GetRows() != a.GetCols())
+    throw std::logic_error("The matrix must be square");
+  h_.SetLayout(S21Layout::kRowMajor);
+  h_.Detach();
+  Hessenberg();
+  Francis();
+}
+
+template <typename T>
+void S21Eigen<T>::Hessenberg() {
+  const int n = h_.rows_;
+  auto a = h_.Rows();
+  auto q = z_.Rows();
+  std::vector<T> v(n), tau(n);
+  for (int k = 0; k + 2 < n; k++) {
+    T sigma = 0;
+    for (int i = k + 2; i < n; i++) sigma += a[i][k] * a[i][k];
+    if (sigma == 0) continue;
+    const T x0 = a[k + 1][k];
+    const T norm = std::sqrt(x0 * x0 + sigma);
+    const T beta = x0 > 0 ? -norm : norm;
+    tau[k] = (beta - x0) / beta;
+    v[k + 1] = 1;
+    for (int i = k + 2; i < n; i++) v[i] = a[i][k] /= x0 - beta;
+    a[k + 1][k] = beta;
+
+    // A = H * A * H: rows k+1.. from the left, columns k+1.. from the right.
+    S21ParallelFor(k + 1, n, kBlock, [&](int j0, int j1) {
+      for (int j = j0; j < j1; j++) {
+        T sum = 0;
+        for (int i = k + 1; i < n; i++) sum += v[i] * a[i][j];
+        sum *= tau[k];
+        for (int i = k + 1; i < n; i++) a[i][j] -= sum * v[i];
+      }
+    });
+    S21ParallelFor(0, n, RowGrain(n - k - 1), [&](int i0, int i1) {
+      for (int i = i0; i < i1; i++) {
+        T sum = 0;
+        for (int j = k + 1; j < n; j++) sum += a[i][j] * v[j];
+        sum *= tau[k];
+        for (int j = k + 1; j < n; j++) a[i][j] -= sum * v[j];
+      }
+    });
+  }
+
+  for (int i = 0; i < n; i++) q[i][i] = 1;
+  S21ParallelFor(0, n, kBlock, [&](int j0, int j1) {
+    std::vector<T> w(j1 - j0);
+    for (int k = n - 3; k >= 0; k--) {
+      if (tau[k] == 0) continue;
+      for (int j = j0; j < j1; j++) w[j - j0] = q[k + 1][j];
+      for (int i = k + 2; i < n; i++)
+        for (int j = j0; j < j1; j++) w[j - j0] += a[i][k] * q[i][j];
+      for (int j = j0; j < j1; j++) q[k + 1][j] -= tau[k] * w[j - j0];
+      for (int i = k + 2; i < n; i++) {
+        const T tv = tau[k] * a[i][k];
+        for (int j = j0; j < j1; j++) q[i][j] -= tv * w[j - j0];
+      }
+    }
+  });
+  for (int i = 2; i < n; i++)
+    for (int j = 0; j + 1 < i; j++) a[i][j] = 0;
+}
+
+// Francis double-shift QR on the Hessenberg form, accumulating the Schur
+// vectors, with the exceptional shifts of EISPACK hqr2.
+template <typename T>
+void S21Eigen<T>::Francis() {
+  const int size = h_.rows_;
+  const T eps = std::numeric_limits<T>::epsilon();
+  auto a = h_.Rows();
+  auto v = z_.Rows();
+  T norm = 0;
+  for (int i = 0; i < size; i++)
+    for (int j = std::max(i - 1, 0); j < size; j++) norm += std::abs(a[i][j]);
+
+  T exshift = 0, p = 0, q = 0, r = 0, s = 0, z = 0, w, x, y;
+  int n = size - 1, iter = 0;
+  while (n >= 0) {
+    int l = n;
+    for (; l > 0; l--) {
+      s = std::abs(a[l - 1][l - 1]) + std::abs(a[l][l]);
+      if (s == 0) s = norm;
+      if (std::abs(a[l][l - 1]) < eps * s) break;
+    }
+
+    if (l == n) {
+      a[n][n] += exshift;
+      re_[n] = a[n][n];
+      im_[n] = 0;
+      if (n > 0) a[n][n - 1] = 0;
+      n--;
+      iter = 0;
+    } else if (l == n - 1) {
+      w = a[n][n - 1] * a[n - 1][n];
+      p = (a[n - 1][n - 1] - a[n][n]) / 2;
+      q = p * p + w;
+      z = std::sqrt(std::abs(q));
+      a[n][n] += exshift;
+      a[n - 1][n - 1] += exshift;
+      x = a[n][n];
+      if (l > 0) a[l][l - 1] = 0;
+      if (q >= 0) {
+        z = p >= 0 ? p + z : p - z;
+        re_[n - 1] = x + z;
+        re_[n] = z != 0 ? x - w / z : re_[n - 1];
+        im_[n - 1] = im_[n] = 0;
+        x = a[n][n - 1];
+        s = std::abs(x) + std::abs(z);
+        p = x / s;
+        q = z / s;
+        r = std::sqrt(p * p + q * q);
+        p /= r;
+        q /= r;
+        for (int j = n - 1; j < size; j++) {
+          z = a[n - 1][j];
+          a[n - 1][j] = q * z + p * a[n][j];
+          a[n][j] = q * a[n][j] - p * z;
+        }
+        for (int i = 0; i <= n; i++) {
+          z = a[i][n - 1];
+          a[i][n - 1] = q * z + p * a[i][n];
+          a[i][n] = q * a[i][n] - p * z;
+        }
+        for (int i = 0; i < size; i++) {
+          z = v[i][n - 1];
+          v[i][n - 1] = q * z + p * v[i][n];
+          v[i][n] = q * v[i][n] - p * z;
+        }
+        a[n][n - 1] = 0;
+      } else {
+        re_[n - 1] = re_[n] = x + p;
+        im_[n - 1] = z;
+        im_[n] = -z;
+      }
+      n -= 2;
+      iter = 0;
+    } else {
+      x = a[n][n];
+      y = a[n - 1][n - 1];
+      w = a[n][n - 1] * a[n - 1][n];
+      if (iter == 10) {
+        exshift += x;
+        for (int i = 0; i <= n; i++) a[i][i] -= x;
+        s = std::abs(a[n][n - 1]) + std::abs(a[n - 1][n - 2]);
+        x = y = T(0.75) * s;
+        w = T(-0.4375) * s * s;
+      }
+      if (iter == 30) {
+        s = (y - x) / 2;
+        s = s * s + w;
+        if (s > 0) {
+          s = std::sqrt(s);
+          if (y < x) s = -s;
+          s = x - w / ((y - x) / 2 + s);
+          for (int i = 0; i <= n; i++) a[i][i] -= s;
+          exshift += s;
+          x = y = w = T(0.964);
+        }
+      }
+      if (++iter > kMaxIterations * 2)
+        throw std::runtime_error("The eigenvalue iteration did not converge");
+
+      int m = n - 2;
+      for (; m >= l; m--) {
+        z = a[m][m];
+        r = x - z;
+        s = y - z;
+        p = (r * s - w) / a[m + 1][m] + a[m][m + 1];
+        q = a[m + 1][m + 1] - z - r - s;
+        r = a[m + 2][m + 1];
+        s = std::abs(p) + std::abs(q) + std::abs(r);
+        p /= s;
+        q /= s;
+        r /= s;
+        if (m == l) break;
+        if (std::abs(a[m][m - 1]) * (std::abs(q) + std::abs(r)) <
+            eps * (std::abs(p) * (std::abs(a[m - 1][m - 1]) + std::abs(z) +
+                                  std::abs(a[m + 1][m + 1]))))
+          break;
+      }
+      for (int i = m + 2; i <= n; i++) {
+        a[i][i - 2] = 0;
+        if (i > m + 2) a[i][i - 3] = 0;
+      }
+
+      for (int k = m; k <= n - 1; k++) {
+        const bool notlast = k != n - 1;
+        if (k != m) {
+          p = a[k][k - 1];
+          q = a[k + 1][k - 1];
+          r = notlast ? a[k + 2][k - 1] : 0;
+          x = std::abs(p) + std::abs(q) + std::abs(r);
+          if (x == 0) continue;
+          p /= x;
+          q /= x;
+          r /= x;
+        }
+        s = std::sqrt(p * p + q * q + r * r);
+        if (p < 0) s = -s;
+        if (s == 0) continue;
+        if (k != m) {
+          a[k][k - 1] = -s * x;
+          a[k + 1][k - 1] = 0;
+          if (notlast) a[k + 2][k - 1] = 0;
+        } else if (l != m) {
+          a[k][k - 1] = -a[k][k - 1];
+        }
+        p += s;
+        x = p / s;
+        y = q / s;
+        z = r / s;
+        q /= p;
+        r /= p;
+        for (int j = k; j < size; j++) {
+          p = a[k][j] + q * a[k + 1][j];
+          if (notlast) {
+            p += r * a[k + 2][j];
+            a[k + 2][j] -= p * z;
+          }
+          a[k][j] -= p * x;
+          a[k + 1][j] -= p * y;
+        }
+        for (int i = 0; i <= std::min(n, k + 3); i++) {
+          p = x * a[i][k] + y * a[i][k + 1];
+          if (notlast) {
+            p += z * a[i][k + 2];
+            a[i][k + 2] -= p * r;
+          }
+          a[i][k] -= p;
+          a[i][k + 1] -= p * q;
+        }
+        for (int i = 0; i < size; i++) {
+          p = x * v[i][k] + y * v[i][k + 1];
+          if (notlast) {
+            p += z * v[i][k + 2];
+            v[i][k + 2] -= p * r;
+          }
+          v[i][k] -= p;
+          v[i][k + 1] -= p * q;
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Eigen<T>::Real() const {
+  S21BasicMatrix<T> res(h_.rows_, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < h_.rows_; i++) res.Rows()[i][0] = re_[i];
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Eigen<T>::Imag() const {
+  S21BasicMatrix<T> res(h_.rows_, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < h_.rows_; i++) res.Rows()[i][0] = im_[i];
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Eigen<T>::Schur() const {
+  return h_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21Eigen<T>::Z() const {
+  return z_;
+}
+
+template class S21SymmetricEigen<float>;
+template class S21SymmetricEigen<double>;
+template class S21SymmetricEigen<long double>;
+template class S21Eigen<float>;
+template class S21Eigen<double>;
+template class S21Eigen<long double>;
@@ -0,0 +1,70 @@
+#ifndef S21_MATRIX_EIGEN_H_
+#define S21_MATRIX_EIGEN_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// A = V * diag(values) * V^T for a symmetric A, by Householder reduction to
+// tridiagonal form and implicit QL. Only the lower triangle of A is read.
+template <typename T>
+class S21SymmetricEigen {
+ public:
+  explicit S21SymmetricEigen(const S21BasicMatrix<T>& a, bool vectors = true);
+
+  // Eigenvalues in ascending order as an n x 1 matrix.
+  S21BasicMatrix<T> Values() const;
+  // Orthonormal eigenvectors in the columns, matching Values().
+  S21BasicMatrix<T> Vectors() const;
+  // The k largest eigenvalues in descending order, found by Sturm sequence
+  // bisection on the tridiagonal form. The reduction still costs O(n^3),
+  // but the rest of the spectrum is never computed.
+  static S21BasicMatrix<T> Largest(const S21BasicMatrix<T>& a, int k);
+
+ private:
+  S21SymmetricEigen(const S21BasicMatrix<T>& a, bool vectors,
+                    bool diagonalize);
+  void Tridiagonalize();
+  void AccumulateQ();
+  void Diagonalize();
+
+  S21BasicMatrix<T> a_;
+  S21BasicMatrix<T> v_;
+  std::vector<T> d_;
+  std::vector<T> e_;
+  std::vector<T> tau_;
+  bool vectors_;
+};
+
+// Real Schur form A = Z * S * Z^T of a general square matrix, by Hessenberg
+// reduction and Francis double-shift QR. S is upper quasi-triangular: each
+// complex conjugate pair of eigenvalues is a 2 x 2 block on its diagonal.
+template <typename T>
+class S21Eigen {
+ public:
+  explicit S21Eigen(const S21BasicMatrix<T>& a);
+
+  // Real and imaginary parts of the eigenvalues in Schur diagonal order.
+  S21BasicMatrix<T> Real() const;
+  S21BasicMatrix<T> Imag() const;
+  S21BasicMatrix<T> Schur() const;
+  S21BasicMatrix<T> Z() const;
+
+ private:
+  void Hessenberg();
+  void Francis();
+
+  S21BasicMatrix<T> h_;
+  S21BasicMatrix<T> z_;
+  std::vector<T> re_;
+  std::vector<T> im_;
+};
+
+extern template class S21SymmetricEigen<float>;
+extern template class S21SymmetricEigen<double>;
+extern template class S21SymmetricEigen<long double>;
+extern template class S21Eigen<float>;
+extern template class S21Eigen<double>;
+extern template class S21Eigen<long double>;
+
+#endif  // S21_MATRIX_EIGEN_H_
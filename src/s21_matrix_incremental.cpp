@@ -0,0 +1,116 @@
+#include "s21_matrix_incremental.h"
+
+#include "s21_matrix_lu.h"
+
+template <typename T>
+S21IncrementalInverse<T>::S21IncrementalInverse(S21BasicMatrix<T> a, T tol,
+                                                int check_interval)
+    : a_(std::move(a)),
+      det_(0),
+      singular_(true),
+      tol_(tol < 0 ? std::sqrt(std::numeric_limits<T>::epsilon()) : tol),
+      check_interval_(check_interval),
+      unchecked_(0),
+      refactorizations_(0) {
+  if (a_.GetRows() != a_.GetCols())
+    throw std::logic_error("The matrix must be square");
+  if (check_interval < 1) throw std::out_of_range("Out of range");
+  Refactor();
+}
+
+template <typename T>
+void S21IncrementalInverse<T>::Update(const S21BasicMatrix<T>& u,
+                                      const S21BasicMatrix<T>& v) {
+  Apply(1, u, v);
+}
+
+template <typename T>
+void S21IncrementalInverse<T>::Downdate(const S21BasicMatrix<T>& u,
+                                        const S21BasicMatrix<T>& v) {
+  Apply(-1, u, v);
+}
+
+template <typename T>
+void S21IncrementalInverse<T>::Refactor() {
+  S21LU<T> lu(a_);
+  refactorizations_++;
+  unchecked_ = 0;
+  singular_ = lu.IsSingular();
+  det_ = lu.Determinant();
+  if (!singular_) inverse_ = lu.Inverse();
+}
+
+template <typename T>
+void S21IncrementalInverse<T>::Apply(T sign, const S21BasicMatrix<T>& u,
+                                     const S21BasicMatrix<T>& v) {
+  const int n = a_.GetRows(), k = u.GetCols();
+  if (u.GetRows() != n || v.GetRows() != n || v.GetCols() != k)
+    throw std::logic_error("U and V must both be n x k");
+  S21BasicMatrix<T>::Gemm(sign, u, false, v, true, 1, a_);
+  // A singular A has no inverse to update.
+  if (singular_) return Refactor();
+
+  // With C = I + s V^T inv(A) U:
+  // inv(A + s U V^T) = inv(A) - s inv(A) U inv(C) V^T inv(A),
+  // det(A + s U V^T) = det(A) det(C).
+  S21BasicMatrix<T> au(n, k, S21BasicMatrix<T>::kUninitialized);
+  S21BasicMatrix<T> va(k, n, S21BasicMatrix<T>::kUninitialized);
+  S21BasicMatrix<T>::Gemm(1, inverse_, false, u, false, 0, au);
+  S21BasicMatrix<T>::Gemm(1, v, true, inverse_, false, 0, va);
+  S21BasicMatrix<T> c = S21BasicMatrix<T>::Identity(k);
+  S21BasicMatrix<T>::Gemm(sign, v, true, au, false, 1, c);
+  S21LU<T> lu(std::move(c));
+  // A singular C means the updated A is singular too.
+  if (lu.IsSingular()) return Refactor();
+  det_ *= lu.Determinant();
+  lu.SolveInPlace(va);
+  S21BasicMatrix<T>::Gemm(-sign, au, false, va, false, 1, inverse_);
+
+  if (++unchecked_ < check_interval_) return;
+  unchecked_ = 0;
+  if (Drifted()) Refactor();
+}
+
+template <typename T>
+bool S21IncrementalInverse<T>::Drifted() {
+  const int n = a_.GetRows();
+  S21BasicMatrix<T> x(n, 1, S21BasicMatrix<T>::kUninitialized);
+  S21BasicMatrix<T> y(n, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < n; i++) x(i, 0) = probe_() & 1 ? 1 : -1;
+  S21BasicMatrix<T> r(x);
+  S21BasicMatrix<T>::Gemm(1, inverse_, false, x, false, 0, y);
+  S21BasicMatrix<T>::Gemm(1, a_, false, y, false, -1, r);
+  // The residual of A y = x relative to the size of its terms.
+  const T scale = a_.Norm(S21Norm::kInf) * y.Norm(S21Norm::kInf) + 1;
+  return !(r.Norm(S21Norm::kInf) <= tol_ * scale);
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21IncrementalInverse<T>::A() const noexcept {
+  return a_;
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21IncrementalInverse<T>::Inverse() const {
+  if (singular_) throw std::logic_error("Det = 0");
+  return inverse_;
+}
+
+template <typename T>
+T S21IncrementalInverse<T>::Determinant() const noexcept {
+  return singular_ ? 0 : det_;
+}
+
+template <typename T>
+bool S21IncrementalInverse<T>::IsSingular() const noexcept {
+  return singular_;
+}
+
+template <typename T>
+int S21IncrementalInverse<T>::Refactorizations() const noexcept {
+  return refactorizations_;
+}
+
+template class S21IncrementalInverse<float>;
+template class S21IncrementalInverse<double>;
+template class S21IncrementalInverse<long double>;
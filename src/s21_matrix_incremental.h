@@ -0,0 +1,54 @@
+#ifndef S21_MATRIX_INCREMENTAL_H_
+#define S21_MATRIX_INCREMENTAL_H_
+
+#include <random>
+
+#include "s21_matrix_oop.h"
+
+// A square matrix with its inverse and determinant kept current under
+// low-rank changes. Update(U, V) sets A += U * V^T for n x k U and V in
+// O(n^2 k) by the Woodbury identity and the matrix determinant lemma;
+// k = 1 is the Sherman-Morrison case. Every `check_interval` updates the
+// inverse is checked against A on a random probe vector, and A is factored
+// again if the relative residual exceeds tol. A negative tol uses
+// sqrt(epsilon).
+template <typename T>
+class S21IncrementalInverse {
+ public:
+  explicit S21IncrementalInverse(S21BasicMatrix<T> a, T tol = -1,
+                                 int check_interval = 1);
+
+  void Update(const S21BasicMatrix<T>& u, const S21BasicMatrix<T>& v);
+  // A -= U * V^T.
+  void Downdate(const S21BasicMatrix<T>& u, const S21BasicMatrix<T>& v);
+  // Factors A from scratch in O(n^3).
+  void Refactor();
+
+  const S21BasicMatrix<T>& A() const noexcept;
+  // Throws if A is singular.
+  const S21BasicMatrix<T>& Inverse() const;
+  T Determinant() const noexcept;
+  bool IsSingular() const noexcept;
+  // Factorizations so far, the one made by the constructor included.
+  int Refactorizations() const noexcept;
+
+ private:
+  void Apply(T sign, const S21BasicMatrix<T>& u, const S21BasicMatrix<T>& v);
+  bool Drifted();
+
+  S21BasicMatrix<T> a_;
+  S21BasicMatrix<T> inverse_;
+  T det_;
+  bool singular_;
+  T tol_;
+  int check_interval_;
+  int unchecked_;
+  int refactorizations_;
+  std::mt19937 probe_;
+};
+
+extern template class S21IncrementalInverse<float>;
+extern template class S21IncrementalInverse<double>;
+extern template class S21IncrementalInverse<long double>;
+
+#endif  // S21_MATRIX_INCREMENTAL_H_
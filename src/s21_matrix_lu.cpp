@@ -0,0 +1,156 @@
+#include "s21_matrix_lu.h"
+
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+template <typename T>
+S21LU<T>::S21LU(S21BasicMatrix<T> a)
+    : lu_(std::move(a)), pivots_(lu_.rows_), sign_(1), singular_(false) {
+  if (lu_.rows_ != lu_.cols_)
+    throw std::logic_error("The matrix must be square");
+  const int n = lu_.rows_;
+  lu_.SetLayout(S21Layout::kRowMajor);
+  lu_.Detach();
+  auto m = lu_.Rows();
+
+  // Right-looking blocked LU: the panel task of step k factors one column
+  // tile, the update tasks apply it to the tiles on its right. Each tile
+  // only waits for its own previous update, so the next panel can start
+  // while the rest of the trailing matrix is still being updated.
+  const int block = S21Tuning::Get().factor_block;
+  const int tiles = (n + block - 1) / block;
+  std::vector<int> last(tiles, -1);
+  S21TaskGraph graph;
+  for (int k = 0; k < tiles; k++) {
+    const int k0 = k * block, k1 = std::min(n, k0 + block);
+    last[k] = graph.Add([=] { FactorPanel(k0, k1); }, {last[k]});
+    for (int j = k + 1; j < tiles; j++) {
+      const int j0 = j * block, j1 = std::min(n, j0 + block);
+      last[j] =
+          graph.Add([=] { UpdateTile(k0, k1, j0, j1); }, {last[k], last[j]});
+    }
+  }
+  graph.Run(tiles > 1 ? S21Runtime::Threads() : 1);
+
+  for (int r = 0; r < n; r++)
+    if (pivots_[r] != r)
+      std::swap_ranges(m[r], m[r] + r / block * block, m[pivots_[r]]);
+
+  // u_cc = a_cc - sum l_ck u_kc. A pivot within the rounding error of that
+  // sum is what is left of an exact zero; one that no subtraction touched,
+  // however small, is exact.
+  const T eps = n * std::numeric_limits<T>::epsilon();
+  for (int c = 0; c < n && !singular_; c++) {
+    T bound = 0;
+    for (int k = 0; k < c; k++) bound += std::abs(m[c][k] * m[k][c]);
+    singular_ = std::abs(m[c][c]) <= eps * bound;
+  }
+}
+
+template <typename T>
+void S21LU<T>::FactorPanel(int k0, int k1) {
+  const int n = lu_.rows_;
+  auto m = lu_.Rows();
+  for (int c = k0; c < k1; c++) {
+    int p = c;
+    for (int i = c + 1; i < n; i++)
+      if (std::abs(m[i][c]) > std::abs(m[p][c])) p = i;
+    pivots_[c] = p;
+    if (p != c) {
+      std::swap_ranges(m[c] + k0, m[c] + k1, m[p] + k0);
+      sign_ = -sign_;
+    }
+    if (m[c][c] == 0) {
+      singular_ = true;
+      for (int i = c + 1; i < n; i++) m[i][c] = 0;
+      continue;
+    }
+    for (int i = c + 1; i < n; i++) {
+      const T l = m[i][c] /= m[c][c];
+      for (int j = c + 1; j < k1; j++) m[i][j] -= l * m[c][j];
+    }
+  }
+}
+
+template <typename T>
+void S21LU<T>::UpdateTile(int k0, int k1, int j0, int j1) {
+  const int n = lu_.rows_;
+  auto m = lu_.Rows();
+  for (int r = k0; r < k1; r++)
+    if (pivots_[r] != r)
+      std::swap_ranges(m[r] + j0, m[r] + j1, m[pivots_[r]] + j0);
+  for (int r = k0 + 1; r < k1; r++)
+    for (int c = k0; c < r; c++) {
+      const T l = m[r][c];
+      for (int j = j0; j < j1; j++) m[r][j] -= l * m[c][j];
+    }
+  for (int i = k1; i < n; i++)
+    for (int c = k0; c < k1; c++) {
+      const T l = m[i][c];
+      if (l == 0) continue;
+      for (int j = j0; j < j1; j++) m[i][j] -= l * m[c][j];
+    }
+}
+
+template <typename T>
+bool S21LU<T>::IsSingular() const noexcept {
+  return singular_;
+}
+
+template <typename T>
+T S21LU<T>::Determinant() const noexcept {
+  if (singular_) return 0;
+  T det = sign_;
+  for (int i = 0; i < lu_.rows_; i++) det *= lu_.Rows()[i][i];
+  return det;
+}
+
+template <typename T>
+void S21LU<T>::SolveInPlace(S21BasicMatrix<T>& b) const {
+  const int n = lu_.rows_;
+  if (b.GetRows() != n)
+    throw std::logic_error("The right-hand side must have as many rows as A");
+  if (singular_) throw std::logic_error("Det = 0");
+  b.SetLayout(S21Layout::kRowMajor);
+  b.Detach();
+  auto m = lu_.Rows();
+  auto x = b.Rows();
+  for (int r = 0; r < n; r++)
+    if (pivots_[r] != r)
+      std::swap_ranges(x[r], x[r] + b.cols_, x[pivots_[r]]);
+
+  const int block = S21Tuning::Get().factor_block;
+  S21TaskGraph graph;
+  for (int j0 = 0; j0 < b.cols_; j0 += block) {
+    const int j1 = std::min(b.cols_, j0 + block);
+    graph.Add([=] {
+      for (int i = 1; i < n; i++)
+        for (int k = 0; k < i; k++)
+          for (int j = j0; j < j1; j++) x[i][j] -= m[i][k] * x[k][j];
+      for (int i = n - 1; i >= 0; i--) {
+        for (int k = i + 1; k < n; k++)
+          for (int j = j0; j < j1; j++) x[i][j] -= m[i][k] * x[k][j];
+        for (int j = j0; j < j1; j++) x[i][j] /= m[i][i];
+      }
+    });
+  }
+  graph.Run(S21Runtime::Threads());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21LU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21LU<T>::Inverse() const {
+  S21BasicMatrix<T> x = S21BasicMatrix<T>::Identity(lu_.rows_);
+  SolveInPlace(x);
+  return x;
+}
+
+template class S21LU<float>;
+template class S21LU<double>;
+template class S21LU<long double>;
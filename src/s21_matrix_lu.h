@@ -0,0 +1,39 @@
+#ifndef S21_MATRIX_LU_H_
+#define S21_MATRIX_LU_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+template <typename T>
+class S21LU {
+ public:
+  // Takes a by value, so a temporary is factored without another copy.
+  explicit S21LU(S21BasicMatrix<T> a);
+
+  // True if a pivot is zero or no larger than the rounding error of the
+  // elimination that produced it. Tiny pivots of exact input count as
+  // nonzero; use S21BasicMatrix::IsSingular for a tolerance.
+  bool IsSingular() const noexcept;
+  T Determinant() const noexcept;
+  // A column-major b is switched to row-major first.
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Inverse() const;
+
+ private:
+  void FactorPanel(int k0, int k1);
+  void UpdateTile(int k0, int k1, int j0, int j1);
+
+  S21BasicMatrix<T> lu_;
+  // Row r was swapped with row pivots_[r] at step r.
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+};
+
+extern template class S21LU<float>;
+extern template class S21LU<double>;
+extern template class S21LU<long double>;
+
+#endif  // S21_MATRIX_LU_H_
@@ -1,119 +1,581 @@
 #include "s21_matrix_oop.h"
 
-S21Matrix::S21Matrix() noexcept {
-  rows_ = 3;
-  cols_ = 3;
-  matrix_ = new double* [rows_] {};
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]{};
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) = i * 3 + j + 1;
-    }
-  }
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <new>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_qr.h"
+#include "s21_matrix_stats.h"
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix() noexcept : refs_(nullptr) {
+  S21_STATS_SCOPE(S21Op::kConstruct, 0, 9 * sizeof(T), 1);
+  Allocate(3, 3, false);
+  for (int k = 0; k < 9; k++) data_[k] = k + 1;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols) : refs_(nullptr) {
   if (rows < 1 || cols < 1) throw std::length_error("Bad size");
+  S21_STATS_SCOPE(S21Op::kConstruct, 0, 1ull * rows * cols * sizeof(T), 1);
+  Allocate(rows, cols);
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols, UninitializedTag)
+    : refs_(nullptr) {
+  if (rows < 1 || cols < 1) throw std::length_error("Bad size");
+  S21_STATS_SCOPE(S21Op::kConstruct, 0, 0, 1);
+  Allocate(rows, cols, false);
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols, T fill)
+    : refs_(nullptr) {
+  if (rows < 1 || cols < 1) throw std::length_error("Bad size");
+  S21_STATS_SCOPE(S21Op::kConstruct, 0, 1ull * rows * cols * sizeof(T), 1);
+  Allocate(rows, cols, false);
+  const size_t size = static_cast<size_t>(rows) * cols;
+  ForRowBands(rows, cols, size, [this, fill](int i0, int i1) {
+    for (int i = i0; i < i1; i++) std::fill_n(Rows()[i], cols_, fill);
+  });
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Identity(int n) {
+  S21BasicMatrix<T> res(n, n);
+  for (int i = 0; i < n; i++) res.Rows()[i][i] = 1;
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Scratch(int rows, int cols,
+                                             S21Layout layout) {
+  const bool col_major = layout == S21Layout::kColMajor;
+  S21BasicMatrix<T> res(col_major ? cols : rows, col_major ? rows : cols,
+                        kUninitialized);
+  res.layout_ = layout;
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols, S21Layout layout)
+    : S21BasicMatrix(layout == S21Layout::kColMajor ? cols : rows,
+                     layout == S21Layout::kColMajor ? rows : cols) {
+  layout_ = layout;
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<T>& other) noexcept
+    : cols_(other.cols_),
+      rows_(other.rows_),
+      row_capacity_(other.row_capacity_),
+      stride_(other.stride_),
+      data_(other.data_),
+      refs_(other.refs_),
+      layout_(other.layout_) {
+  if (refs_ && !other.leaked_) {
+    S21_STATS_SCOPE(S21Op::kCopy, 0, 0, 0);
+    refs_->fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  S21_STATS_SCOPE(S21Op::kCopy, 0,
+                  2ull * other.rows_ * other.cols_ * sizeof(T), 1);
+  refs_ = other.refs_ ? new std::atomic<int>(1) : nullptr;
+  Allocate(other.rows_, other.cols_, false);
+  const size_t size = static_cast<size_t>(rows_) * stride_;
+  ForRowBands(rows_, stride_, size, [&](int i0, int i1) {
+    for (int i = i0; i < i1; i++)
+      std::copy_n(other.Rows()[i], cols_, Rows()[i]);
+  });
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix<T>&& other) noexcept
+    : cols_(other.cols_),
+      rows_(other.rows_),
+      row_capacity_(other.row_capacity_),
+      stride_(other.stride_),
+      data_(other.data_),
+      refs_(other.refs_),
+      layout_(other.layout_),
+      leaked_(other.leaked_) {
+  S21_STATS_SCOPE(S21Op::kMove, 0, 0, 0);
+  other.leaked_ = false;
+  other.row_capacity_ = 0;
+  other.data_ = nullptr;
+  other.refs_ = nullptr;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+}
+
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() noexcept {
+  Release();
+  cols_ = 0;
+  rows_ = 0;
+}
+
+namespace {
+
+constexpr size_t kHugePage = size_t(2) << 20;
+
+size_t MappedSize(size_t bytes) {
+  static const size_t page = sysconf(_SC_PAGESIZE);
+  return (bytes + page - 1) / page * page;
+}
+
+// Anonymous pages read as zero and get memory only when first written. The
+// mapping starts on a huge page boundary so that its whole huge pages can be
+// backed by transparent huge pages; the tail is rounded to the base page.
+void* MapPages(size_t bytes) {
+  const size_t size = MappedSize(bytes);
+  void* raw = mmap(nullptr, size + kHugePage, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) throw std::bad_alloc();
+  char* base = static_cast<char*>(raw);
+  const size_t head =
+      (kHugePage - reinterpret_cast<uintptr_t>(base) % kHugePage) % kHugePage;
+  if (head > 0) munmap(base, head);
+  munmap(base + head + size, kHugePage - head);
+#ifdef MADV_HUGEPAGE
+  madvise(base + head, size, MADV_HUGEPAGE);
+#endif
+  return base + head;
+}
+
+}  // namespace
+
+template <typename T>
+T* S21BasicMatrix<T>::NewBuffer(size_t size, bool zero) {
+  if (size * sizeof(T) >= kLargeBuffer)
+    return static_cast<T*>(MapPages(size * sizeof(T)));
+  return zero ? new T[size]{} : new T[size];
+}
+
+template <typename T>
+void S21BasicMatrix<T>::DeleteBuffer(T* data, size_t size) noexcept {
+  if (size * sizeof(T) >= kLargeBuffer)
+    munmap(data, MappedSize(size * sizeof(T)));
+  else
+    delete[] data;
+}
+
+template <typename T>
+template <typename Body>
+void S21BasicMatrix<T>::ForRowBands(int rows, int stride, size_t size,
+                                    Body body) {
+  if (size * sizeof(T) < kLargeBuffer) {
+    body(0, rows);
+    return;
+  }
+  S21ParallelFor(0, rows,
+                 std::max(1, S21Tuning::Get().parallel_grain / stride), body);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Allocate(int rows, int cols, bool zero) {
   rows_ = rows;
   cols_ = cols;
-  matrix_ = new double* [rows_] {};
-  for (int i = 0; i < rows_; i++) matrix_[i] = new double[cols_]{};
+  row_capacity_ = rows;
+  stride_ = cols;
+  const size_t size = static_cast<size_t>(rows) * cols;
+  data_ = NewBuffer(size, zero);
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other) noexcept {
-  cols_ = other.cols_;
-  rows_ = other.rows_;
-  matrix_ = new double* [rows_] {};
+template <typename T>
+void S21BasicMatrix<T>::Reallocate(int row_capacity, int col_capacity) {
+  S21_STATS_SCOPE(S21Op::kCopy, 0, 2ull * rows_ * cols_ * sizeof(T),
+                  refs_ ? 2 : 1);
+  const size_t size = static_cast<size_t>(row_capacity) * col_capacity;
+  T* data = NewBuffer(size, true);
+  std::atomic<int>* refs = refs_ ? new std::atomic<int>(1) : nullptr;
+  ForRowBands(rows_, col_capacity, size, [&](int i0, int i1) {
+    for (int i = i0; i < i1; i++)
+      std::copy_n(Rows()[i], cols_,
+                  data + static_cast<size_t>(i) * col_capacity);
+  });
+  Release();
+  data_ = data;
+  refs_ = refs;
+  row_capacity_ = row_capacity;
+  stride_ = col_capacity;
+}
 
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]{};
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) = other(i, j);
+template <typename T>
+void S21BasicMatrix<T>::Release() noexcept {
+  if (refs_) {
+    if (refs_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete refs_;
+      DeleteBuffer(data_, static_cast<size_t>(row_capacity_) * stride_);
     }
+  } else {
+    DeleteBuffer(data_, static_cast<size_t>(row_capacity_) * stride_);
   }
+  refs_ = nullptr;
+  data_ = nullptr;
+  leaked_ = false;
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept {
-  cols_ = other.cols_;
-  rows_ = other.rows_;
-  matrix_ = new double* [rows_ * cols_] {};
+template <typename T>
+void S21BasicMatrix<T>::Detach() {
+  // Every writer comes through here, and the buffer may be shared again
+  // once a reference from operator() has been invalidated by one.
+  leaked_ = false;
+  if (IsShared()) Reallocate(row_capacity_, stride_);
+}
 
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]{};
+template <typename T>
+void S21BasicMatrix<T>::Swap(S21BasicMatrix<T>& other) noexcept {
+  std::swap(cols_, other.cols_);
+  std::swap(rows_, other.rows_);
+  std::swap(row_capacity_, other.row_capacity_);
+  std::swap(stride_, other.stride_);
+  std::swap(data_, other.data_);
+  std::swap(refs_, other.refs_);
+  std::swap(layout_, other.layout_);
+  std::swap(leaked_, other.leaked_);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Adopt(S21BasicMatrix<T>& other) {
+  if (refs_) other.SetCopyOnWrite(true);
+  Swap(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetCopyOnWrite(bool enabled) {
+  leaked_ = false;
+  if (enabled && !refs_) {
+    refs_ = new std::atomic<int>(1);
+  } else if (!enabled && refs_) {
+    Detach();
+    delete refs_;
+    refs_ = nullptr;
+  }
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsCopyOnWrite() const noexcept {
+  return refs_ != nullptr;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsShared() const noexcept {
+  return refs_ && refs_->load(std::memory_order_acquire) > 1;
+}
+
+template <typename T>
+S21Layout S21BasicMatrix<T>::GetLayout() const noexcept {
+  return layout_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SetLayout(S21Layout layout) {
+  if (layout == layout_) return;
+  S21_STATS_SCOPE(S21Op::kTranspose, 0, 2ull * rows_ * cols_ * sizeof(T), 1);
+  S21BasicMatrix<T> res(cols_, rows_, kUninitialized);
+  const int block = S21Tuning::Get().transpose_block;
+  for (int i0 = 0; i0 < rows_; i0 += block)
+    for (int j0 = 0; j0 < cols_; j0 += block)
+      for (int i = i0; i < std::min(rows_, i0 + block); i++)
+        for (int j = j0; j < std::min(cols_, j0 + block); j++)
+          res.Rows()[j][i] = Rows()[i][j];
+  res.layout_ = layout;
+  Adopt(res);
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::SameSize(
+    const S21BasicMatrix<T>& other) const noexcept {
+  return GetRows() == other.GetRows() && GetCols() == other.GetCols();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Stored() const {
+  S21BasicMatrix<T> res(*this);
+  res.layout_ = S21Layout::kRowMajor;
+  return res;
+}
+
+// Mixed layouts gather a band of the other matrix's stored columns at a
+// time, so both arrays are still read along their rows.
+template <typename T>
+template <typename Body>
+bool S21BasicMatrix<T>::ForRowPairs(const S21BasicMatrix<T>& other,
+                                    Body body) const {
+  if (layout_ == other.layout_) {
+    for (int i = 0; i < rows_; i++)
+      if (!body(i, other.Rows()[i])) return false;
+    return true;
+  }
+  const int block = S21Tuning::Get().transpose_block;
+  std::vector<T> band(static_cast<size_t>(block) * cols_);
+  for (int i0 = 0; i0 < rows_; i0 += block) {
+    const int i1 = std::min(rows_, i0 + block);
     for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) = other(i, j);
+      const T* src = other.Rows()[j];
+      for (int i = i0; i < i1; i++)
+        band[static_cast<size_t>(i - i0) * cols_ + j] = src[i];
     }
+    for (int i = i0; i < i1; i++)
+      if (!body(i, band.data() + static_cast<size_t>(i - i0) * cols_))
+        return false;
   }
-  for (int i = 0; i < other.rows_; i++) delete[] other.matrix_[i];
-  delete[] other.matrix_;
-  other.matrix_ = nullptr;
-  other.rows_ = 0;
-  other.cols_ = 0;
+  return true;
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix<T>& other) const {
+  return EqMatrix(other, S21Tolerance<T>::Absolute(eps));
 }
 
-S21Matrix::~S21Matrix() noexcept {
-  if (matrix_) {
-    for (int i = 0; i < rows_; i++) delete[] matrix_[i];
-    delete[] matrix_;
+namespace {
+
+constexpr int kCompareChunk = 16;
+
+template <typename T>
+T ElementError(typename S21Tolerance<T>::Kind kind, T a, T b) {
+  using Kind = typename S21Tolerance<T>::Kind;
+  if (a == b) return 0;
+  const T diff = std::abs(a - b);
+  if (kind == Kind::kAbsolute || kind == Kind::kNorm) return diff;
+  const T scale = std::max(std::abs(a), std::abs(b));
+  if (kind == Kind::kRelative) return diff / scale;
+  return diff / (std::nextafter(scale, std::numeric_limits<T>::infinity()) -
+                 scale);
+}
+
+// Checks a chunk at a time so the inner loop has no early exit branch.
+template <typename T, typename Error>
+bool RowWithin(const T* a, const T* b, int cols, T limit, Error error) {
+  for (int j0 = 0; j0 < cols; j0 += kCompareChunk) {
+    const int j1 = std::min(cols, j0 + kCompareChunk);
+    bool ok = true;
+    for (int j = j0; j < j1; j++) ok &= error(a[j], b[j]) <= limit;
+    if (!ok) return false;
   }
-  cols_ = 0;
-  rows_ = 0;
-  matrix_ = nullptr;
+  return true;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) const {
-  bool res = true;
-  if (this->cols_ != other.cols_ || this->rows_ != other.rows_)
-    res = false;
-  else
-    for (int i = 0; i < rows_ && res; i++)
-      for (int j = 0; j < cols_ && res; j++)
-        if (std::abs((*this)(i, j) - other(i, j)) > eps) res = false;
+}  // namespace
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix<T>& other,
+                                 const S21Tolerance<T>& tolerance) const {
+  using Kind = typename S21Tolerance<T>::Kind;
+  if (!SameSize(other)) return false;
+  const T limit = tolerance.value;
+  switch (tolerance.kind) {
+    case Kind::kAbsolute:
+      return ForRowPairs(other, [&](int i, const T* b) {
+        return RowWithin(Rows()[i], b, cols_, limit,
+                         [](T x, T y) { return x == y ? 0 : std::abs(x - y); });
+      });
+    case Kind::kRelative:
+      return ForRowPairs(other, [&](int i, const T* b) {
+        return RowWithin(Rows()[i], b, cols_, T(0), [limit](T x, T y) {
+          return x == y ? 0
+                        : std::abs(x - y) -
+                              limit * std::max(std::abs(x), std::abs(y));
+        });
+      });
+    case Kind::kUlp:
+      return ForRowPairs(other, [&](int i, const T* b) {
+        return RowWithin(Rows()[i], b, cols_, limit, [](T x, T y) {
+          return ElementError(Kind::kUlp, x, y);
+        });
+      });
+    case Kind::kNorm: {
+      T norm = 0;
+      for (int i = 0; i < rows_; i++)
+        for (int j = 0; j < cols_; j++) norm += Rows()[i][j] * Rows()[i][j];
+      const T bound = limit * limit * norm;
+      T diff = 0;
+      return ForRowPairs(other, [&](int i, const T* b) {
+        const T* a = Rows()[i];
+        for (int j = 0; j < cols_; j++) diff += (a[j] - b[j]) * (a[j] - b[j]);
+        return diff <= bound;
+      });
+    }
+  }
+  return false;
+}
 
+template <typename T>
+S21Comparison<T> S21BasicMatrix<T>::Compare(
+    const S21BasicMatrix<T>& other, const S21Tolerance<T>& tolerance) const {
+  using Kind = typename S21Tolerance<T>::Kind;
+  S21Comparison<T> res{false, -1, -1, 0};
+  if (!SameSize(other)) return res;
+  T norm = 0, diff = 0;
+  ForRowPairs(other, [&](int i, const T* b) {
+    const T* a = Rows()[i];
+    for (int j = 0; j < cols_; j++) {
+      const T error = ElementError(tolerance.kind, a[j], b[j]);
+      if (error != 0 && !(error <= res.max_error) &&
+          !std::isnan(res.max_error)) {
+        res.max_error = error;
+        res.row = ColMajor() ? j : i;
+        res.col = ColMajor() ? i : j;
+      }
+      norm += a[j] * a[j];
+      diff += (a[j] - b[j]) * (a[j] - b[j]);
+    }
+    return true;
+  });
+  if (tolerance.kind == Kind::kNorm)
+    res.max_error = diff == 0 ? 0 : std::sqrt(diff) / std::sqrt(norm);
+  res.equal = res.max_error <= tolerance.value;
   return res;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
-  if (cols_ != other.cols_ || rows_ != other.rows_)
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix<T>& other) {
+  S21_STATS_SCOPE(S21Op::kSum, 1ull * rows_ * cols_,
+                  3ull * rows_ * cols_ * sizeof(T), 0);
+  if (!SameSize(other))
     throw std::logic_error("Matrices must be the same size");
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) (*this)(i, j) += other(i, j);
+  Detach();
+  ForRowPairs(other, [this](int i, const T* b) {
+    T* a = Rows()[i];
+    for (int j = 0; j < cols_; j++) a[j] += b[j];
+    return true;
+  });
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
-  if (cols_ != other.cols_ || rows_ != other.rows_)
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix<T>& other) {
+  S21_STATS_SCOPE(S21Op::kSub, 1ull * rows_ * cols_,
+                  3ull * rows_ * cols_ * sizeof(T), 0);
+  if (!SameSize(other))
     throw std::logic_error("Matrices must be the same size");
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) (*this)(i, j) -= other(i, j);
+  Detach();
+  ForRowPairs(other, [this](int i, const T* b) {
+    T* a = Rows()[i];
+    for (int j = 0; j < cols_; j++) a[j] -= b[j];
+    return true;
+  });
 }
-void S21Matrix::MulNumber(const double num) noexcept {
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) (*this)(i, j) *= num;
+
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) noexcept {
+  S21_STATS_SCOPE(S21Op::kMulNumber, 1ull * rows_ * cols_,
+                  2ull * rows_ * cols_ * sizeof(T), 0);
+  Detach();
+  for (int i = 0; i < rows_; i++) {
+    T* row = Rows()[i];
+    for (int j = 0; j < cols_; j++) row[j] *= num;
+  }
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  if (cols_ != other.rows_)
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix<T>& other) {
+  S21_STATS_SCOPE(S21Op::kMulMatrix, 2ull * rows_ * cols_ * other.cols_,
+                  (1ull * rows_ * cols_ + 1ull * other.rows_ * other.cols_ +
+                   1ull * rows_ * other.cols_) *
+                      sizeof(T),
+                  0);
+  S21BasicMatrix<T> res = Scratch(GetRows(), other.GetCols(), layout_);
+  Gemm(1, *this, false, other, false, 0, res);
+  Adopt(res);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Gemm(const T alpha, const S21BasicMatrix<T>& a,
+                             bool trans_a, const S21BasicMatrix<T>& b,
+                             bool trans_b, const T beta, S21BasicMatrix<T>& c) {
+  const int m = trans_a ? a.GetCols() : a.GetRows();
+  const int n = trans_a ? a.GetRows() : a.GetCols();
+  const int p = trans_b ? b.GetRows() : b.GetCols();
+  S21_STATS_SCOPE(S21Op::kGemm, 2ull * m * n * p,
+                  (1ull * m * n + 1ull * n * p + 2ull * m * p) * sizeof(T), 0);
+  if (n != (trans_b ? b.GetCols() : b.GetRows()))
     throw std::logic_error(
         "The columns of the first matrix must be equal to the rows of the "
         "second matrix");
-  S21Matrix res(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < other.cols_; j++)
-      for (int k = 0; k < cols_; k++) res(i, j) += (*this)(i, k) * other(k, j);
+  if (c.GetRows() != m || c.GetCols() != p)
+    throw std::logic_error("The output matrix has the wrong size");
+  if (&c == &a || &c == &b)
+    throw std::logic_error("The output matrix must not alias an operand");
+
+  // A column-major operand is its stored array transposed; a column-major
+  // output stores C^T = op(B)^T * op(A)^T.
+  const bool ta = trans_a != a.ColMajor(), tb = trans_b != b.ColMajor();
+  c.Detach();
+  if (c.ColMajor())
+    GemmKernel(alpha, b, !tb, a, !ta, beta, c);
+  else
+    GemmKernel(alpha, a, ta, b, tb, beta, c);
+}
 
-  *this = res;
+template <typename T>
+void S21BasicMatrix<T>::GemmKernel(const T alpha, const S21BasicMatrix<T>& a,
+                                   bool trans_a, const S21BasicMatrix<T>& b,
+                                   bool trans_b, const T beta,
+                                   S21BasicMatrix<T>& c) {
+  const int m = c.rows_, n = trans_a ? a.rows_ : a.cols_, p = c.cols_;
+  const S21TuningProfile tuning = S21Tuning::Get();
+  auto cm = c.Rows();
+  auto am = a.Rows();
+  auto bm = b.Rows();
+  // Bands of C rows run in parallel. Every element still accumulates over
+  // k in ascending order, so the result does not depend on the bands.
+  const int band = std::max(1, tuning.parallel_grain / std::max(p, 1));
+  S21ParallelFor(0, m, band, [&](int i0, int i1) {
+    for (int i = i0; i < i1; i++)
+      for (int j = 0; j < p; j++) cm[i][j] = beta == 0 ? 0 : cm[i][j] * beta;
+    if (alpha == 0) return;
+
+    if (!trans_b) {
+      const int block = tuning.gemm_block;
+      for (int kk = 0; kk < n; kk += block)
+        for (int jj = 0; jj < p; jj += block) {
+          const int k_end = std::min(kk + block, n);
+          const int j_end = std::min(jj + block, p);
+          for (int i = i0; i < i1; i++)
+            for (int k = kk; k < k_end; k++) {
+              const T aik = alpha * (trans_a ? am[k][i] : am[i][k]);
+              const T* b_row = bm[k];
+              T* c_row = cm[i];
+              for (int j = jj; j < j_end; j++) c_row[j] += aik * b_row[j];
+            }
+        }
+    } else {
+      for (int i = i0; i < i1; i++)
+        for (int j = 0; j < p; j++) {
+          const T* b_row = bm[j];
+          T sum = 0;
+          if (trans_a)
+            for (int k = 0; k < n; k++) sum += am[k][i] * b_row[k];
+          else
+            for (int k = 0; k < n; k++) sum += am[i][k] * b_row[k];
+          cm[i][j] += alpha * sum;
+        }
+    }
+  });
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix res(cols_, rows_);
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) res(j, i) = (*this)(i, j);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21_STATS_SCOPE(S21Op::kTranspose, 0, 0, 0);
+  S21BasicMatrix<T> res(*this);
+  res.layout_ = ColMajor() ? S21Layout::kRowMajor : S21Layout::kColMajor;
   return res;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (rows_ != cols_) throw std::logic_error("The matrix must be square");
-  S21Matrix calc(rows_, rows_);
+  S21_STATS_SCOPE(S21Op::kCalcComplements, 0, 1ull * rows_ * rows_ * sizeof(T),
+                  0);
+  S21BasicMatrix<T> calc(rows_, rows_, kUninitialized);
   if (rows_ == 1)
     calc(0, 0) = (*this)(0, 0);
   else {
@@ -126,120 +588,714 @@ S21Matrix S21Matrix::CalcComplements() {
   return calc;
 }
 
-double S21Matrix::Determinant() {
-  double det = 0;
+template <typename T>
+T S21BasicMatrix<T>::Determinant() const {
+  if (cols_ != rows_) throw std::logic_error("The matrix must be square");
+  S21_STATS_SCOPE(S21Op::kDeterminant, 2ull * rows_ * rows_ * rows_ / 3,
+                  1ull * rows_ * rows_ * sizeof(T), 0);
+  // det(A^T) = det(A), so the stored array is factored as is.
+  return S21LU<T>(ColMajor() ? Stored() : *this).Determinant();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
   if (cols_ != rows_) throw std::logic_error("The matrix must be square");
+  S21_STATS_SCOPE(S21Op::kInverse, 2ull * rows_ * rows_ * rows_,
+                  2ull * rows_ * rows_ * sizeof(T), 0);
+  // inv(A^T) = inv(A)^T: the inverse of the stored array, in this layout.
+  S21LU<T> lu(ColMajor() ? Stored() : *this);
+  if (lu.IsSingular()) throw std::logic_error("Det = 0");
+  S21BasicMatrix<T> res = lu.Inverse();
+  res.layout_ = layout_;
+  return res;
+}
 
-  if (cols_ == 1)
-    det = (*this)(0, 0);
-  else {
-    int sign = 1;
-    for (int i = 0; i < cols_; i++) {
-      det += (*this)(i, 0) * sign * (this->GetMinor(i, 0)).Determinant();
-      sign *= -1;
+template <typename T>
+int S21BasicMatrix<T>::Rank(T tol) const {
+  return S21PivotedQR<T>(*this, tol).Rank();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::NullSpace(T tol) const {
+  return S21PivotedQR<T>(*this, tol).NullSpace();
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::IsSingular(T tol) const {
+  if (rows_ != cols_) throw std::logic_error("The matrix must be square");
+  std::vector<char> used(cols_);
+  for (int i = 0; i < rows_; i++) {
+    const T* row = Rows()[i];
+    bool zero = true;
+    for (int j = 0; j < cols_; j++)
+      if (row[j] != 0) {
+        zero = false;
+        used[j] = 1;
+      }
+    if (zero) return true;
+  }
+  if (std::find(used.begin(), used.end(), 0) != used.end()) return true;
+  return S21PivotedQR<T>(Stored(), tol).Rank() < rows_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrixMixed() const {
+  if (rows_ != cols_) throw std::logic_error("The matrix must be square");
+  if (ColMajor()) {
+    S21BasicMatrix<T> res = Stored().InverseMatrixMixed();
+    res.layout_ = layout_;
+    return res;
+  }
+  const int kMaxRefineSteps = 10;
+  // Anything the float factors cannot refine below this falls back to a
+  // factorization in T.
+  const T tol = std::sqrt(std::numeric_limits<T>::epsilon());
+  S21LU<float> lu{S21BasicMatrix<float>(*this)};
+  if (!lu.IsSingular()) {
+    S21BasicMatrix<T> x(lu.Inverse());
+    T prev = std::numeric_limits<T>::infinity(), norm = prev;
+    for (int step = 0; step < kMaxRefineSteps; step++) {
+      S21BasicMatrix<T> r = Identity(rows_);
+      Gemm(-1, *this, false, x, false, 1, r);
+      norm = r.Norm(S21Norm::kInf);
+      if (norm <= std::numeric_limits<T>::epsilon() || norm > prev / 2) break;
+      prev = norm;
+      S21BasicMatrix<float> correction(r * (1 / norm));
+      lu.SolveInPlace(correction);
+      for (int i = 0; i < rows_; i++)
+        for (int j = 0; j < rows_; j++)
+          x.Rows()[i][j] += norm * T(correction.Rows()[i][j]);
+    }
+    if (norm <= tol) return x;
+  }
+  return S21LU<T>(*this).Inverse();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Power(int k) const {
+  if (rows_ != cols_) throw std::logic_error("The matrix must be square");
+  if (ColMajor()) {
+    S21BasicMatrix<T> res = Stored().Power(k);
+    res.layout_ = layout_;
+    return res;
+  }
+  S21BasicMatrix<T> base(rows_, rows_, kUninitialized);
+  S21BasicMatrix<T> res(rows_, rows_, kUninitialized);
+  S21BasicMatrix<T> tmp(rows_, rows_, kUninitialized);
+  if (k < 0) {
+    S21LU<T> lu(*this);
+    if (lu.IsSingular()) throw std::logic_error("Det = 0");
+    S21BasicMatrix<T> inverse = lu.Inverse();
+    base.Swap(inverse);
+  } else {
+    for (int i = 0; i < rows_; i++)
+      std::copy_n(Rows()[i], cols_, base.Rows()[i]);
+  }
+  // The first set bit copies instead of multiplying by the identity.
+  bool started = false;
+  for (long e = std::abs(static_cast<long>(k)); e > 0; e >>= 1) {
+    if (e & 1) {
+      if (started) {
+        Gemm(1, res, false, base, false, 0, tmp);
+        res.Swap(tmp);
+      } else {
+        for (int i = 0; i < rows_; i++)
+          std::copy_n(base.Rows()[i], cols_, res.Rows()[i]);
+        started = true;
+      }
+    }
+    if (e > 1) {
+      Gemm(1, base, false, base, false, 0, tmp);
+      base.Swap(tmp);
+    }
+  }
+  if (!started) return Identity(rows_);
+  return res;
+}
+
+// Higham's scaling and squaring: the lowest Pade degree whose error bound
+// holds for ||A||_1, otherwise degree 13 on A / 2^s. The thresholds are the
+// double precision ones.
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Exp() const {
+  if (rows_ != cols_) throw std::logic_error("The matrix must be square");
+  if (ColMajor()) {
+    S21BasicMatrix<T> res = Stored().Exp();
+    res.layout_ = layout_;
+    return res;
+  }
+  static const double kTheta[] = {1.495585217958292e-2, 2.539398330063230e-1,
+                                  9.504178996162932e-1, 2.097847961257068,
+                                  5.371920351148152};
+  static const double kCoef[][14] = {
+      {120, 60, 12, 1},
+      {30240, 15120, 3360, 420, 30, 1},
+      {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1},
+      {17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160,
+       110880, 3960, 90, 1},
+      {64764752532480000, 32382376266240000, 7771770303897600,
+       1187353796428800, 129060195264000, 10559470521600, 670442572800,
+       33522128640, 1323241920, 40840800, 960960, 16380, 182, 1}};
+  const int n = rows_;
+  const T norm = Norm(S21Norm::kOne);
+  int degree = 0, squarings = 0;
+  while (degree < 4 && !(norm <= kTheta[degree])) degree++;
+  if (degree == 4 && norm > kTheta[4])
+    squarings = static_cast<int>(std::ceil(std::log2(norm / kTheta[4])));
+
+  S21BasicMatrix<T> a(*this);
+  a.Detach();
+  if (squarings > 0) a.MulNumber(std::ldexp(T(1), -squarings));
+  const double* b = kCoef[degree];
+  // Even powers A^2 .. A^8 for the low degrees, A^2, A^4, A^6 for 13.
+  const int powers = degree < 4 ? degree + 1 : 3;
+  std::vector<S21BasicMatrix<T>> pow;
+  pow.reserve(powers);
+  for (int p = 0; p < powers; p++) {
+    pow.emplace_back(n, n, kUninitialized);
+    Gemm(1, p == 0 ? a : pow[p - 1], false, p == 0 ? a : pow[0], false, 0,
+         pow[p]);
+  }
+
+  auto axpy = [n](S21BasicMatrix<T>& y, double alpha,
+                  const S21BasicMatrix<T>& x) {
+    for (int i = 0; i < n; i++) {
+      T* yr = y.Rows()[i];
+      const T* xr = x.Rows()[i];
+      for (int j = 0; j < n; j++) yr[j] += T(alpha) * xr[j];
+    }
+  };
+  // u = A * (odd terms / A), v = even terms of the numerator.
+  S21BasicMatrix<T> u(n, n, kUninitialized), v(n, n), tmp(n, n);
+  for (int i = 0; i < n; i++) {
+    tmp.Rows()[i][i] = b[1];
+    v.Rows()[i][i] = b[0];
+  }
+  if (degree < 4) {
+    for (int j = 1; j <= degree + 1; j++) {
+      axpy(tmp, b[2 * j + 1], pow[j - 1]);
+      axpy(v, b[2 * j], pow[j - 1]);
+    }
+  } else {
+    S21BasicMatrix<T> high_u(n, n), high_v(n, n);
+    for (int j = 1; j <= 3; j++) {
+      axpy(tmp, b[2 * j + 1], pow[j - 1]);
+      axpy(v, b[2 * j], pow[j - 1]);
+      axpy(high_u, b[2 * j + 7], pow[j - 1]);
+      axpy(high_v, b[2 * j + 6], pow[j - 1]);
+    }
+    Gemm(1, pow[2], false, high_u, false, 1, tmp);
+    Gemm(1, pow[2], false, high_v, false, 1, v);
+  }
+  Gemm(1, a, false, tmp, false, 0, u);
+
+  // (v - u) * R = v + u, then R^(2^s).
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) {
+      tmp.Rows()[i][j] = v.Rows()[i][j] - u.Rows()[i][j];
+      v.Rows()[i][j] += u.Rows()[i][j];
+    }
+  S21BasicMatrix<T> res = S21LU<T>(tmp).Solve(v);
+  for (int i = 0; i < squarings; i++) {
+    Gemm(1, res, false, res, false, 0, tmp);
+    res.Swap(tmp);
+  }
+  return res;
+}
+
+namespace {
+
+constexpr int kPairwiseBase = 32;
+
+template <typename T, typename F>
+T PairwiseSum(const T* x, int n, F f) {
+  if (n <= kPairwiseBase) {
+    T sum = 0;
+    for (int i = 0; i < n; i++) sum += f(x[i]);
+    return sum;
+  }
+  const int half = n / 2;
+  return PairwiseSum(x, half, f) + PairwiseSum(x + half, n - half, f);
+}
+
+template <typename T>
+T PairwiseDot(const T* x, const T* y, int n) {
+  if (n <= kPairwiseBase) {
+    T sum = 0;
+    for (int i = 0; i < n; i++) sum += x[i] * y[i];
+    return sum;
+  }
+  const int half = n / 2;
+  return PairwiseDot(x, y, half) + PairwiseDot(x + half, y + half, n - half);
+}
+
+// Rows per reduction chunk. Reproducible chunks use the compiled-in grain
+// so they depend only on the shape; fast ones give each thread one share of
+// at least the tuned grain.
+int RowChunk(int rows, int cols) {
+  cols = std::max(cols, 1);
+  if (S21Runtime::Determinism() == S21Determinism::kReproducible)
+    return std::max(1, S21TuningProfile().parallel_grain / cols);
+  const int threads = S21Runtime::Threads();
+  return std::max({1, S21Tuning::Get().parallel_grain / cols,
+                   (rows + threads - 1) / threads});
+}
+
+// Runs body(chunk, i0, i1) over the row chunks in parallel.
+template <typename Body>
+void ForRowChunks(int rows, int cols, Body body) {
+  const int chunk = RowChunk(rows, cols);
+  S21ParallelFor(0, rows, chunk,
+                 [&](int i0, int i1) { body(i0 / chunk, i0, i1); });
+}
+
+// Neumaier's compensated addition.
+template <typename T>
+void CompensatedAdd(T& sum, T& comp, T value) {
+  const T t = sum + value;
+  if (std::abs(sum) >= std::abs(value))
+    comp += (sum - t) + value;
+  else
+    comp += (value - t) + sum;
+  sum = t;
+}
+
+// Compensated column sums of f(x): each row chunk keeps its own sums and
+// compensations, which are then merged in chunk order.
+template <typename T, typename View, typename F>
+void ColumnSums(View a, int rows, int cols, F f, T* out) {
+  const int chunk = RowChunk(rows, cols);
+  const int chunks = (rows + chunk - 1) / chunk;
+  std::vector<T> sums(static_cast<size_t>(chunks) * cols);
+  std::vector<T> comps(sums.size());
+  ForRowChunks(rows, cols, [&](int k, int i0, int i1) {
+    T* s = sums.data() + static_cast<size_t>(k) * cols;
+    T* c = comps.data() + static_cast<size_t>(k) * cols;
+    for (int i = i0; i < i1; i++)
+      for (int j = 0; j < cols; j++) CompensatedAdd(s[j], c[j], f(a[i][j]));
+  });
+  for (int j = 0; j < cols; j++) {
+    T sum = 0, comp = 0;
+    for (int k = 0; k < chunks; k++) {
+      CompensatedAdd(sum, comp, sums[static_cast<size_t>(k) * cols + j]);
+      comp += comps[static_cast<size_t>(k) * cols + j];
     }
+    out[j] = sum + comp;
   }
-  return det;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  double det = this->Determinant();
-  if (det == 0) throw std::logic_error("Det = 0");
+// Sums row(i) over all rows. The reproducible tree adds the row values
+// pairwise; the fast one adds them in a running sum per chunk.
+template <typename T, typename F>
+T SumRows(int rows, int cols, F row) {
+  if (S21Runtime::Determinism() == S21Determinism::kReproducible) {
+    std::vector<T> partial(rows);
+    ForRowChunks(rows, cols, [&](int, int i0, int i1) {
+      for (int i = i0; i < i1; i++) partial[i] = row(i);
+    });
+    return PairwiseSum(partial.data(), rows, [](T x) { return x; });
+  }
+  const int chunk = RowChunk(rows, cols);
+  std::vector<T> partial((rows + chunk - 1) / chunk);
+  ForRowChunks(rows, cols, [&](int k, int i0, int i1) {
+    for (int i = i0; i < i1; i++) partial[k] += row(i);
+  });
+  T sum = 0;
+  for (T x : partial) sum += x;
+  return sum;
+}
 
-  return CalcComplements().Transpose() * (1.0 / det);
+}  // namespace
+
+template <typename T>
+T S21BasicMatrix<T>::Trace() const {
+  if (rows_ != cols_) throw std::logic_error("The matrix must be square");
+  T sum = 0, comp = 0;
+  for (int i = 0; i < rows_; i++) CompensatedAdd(sum, comp, Rows()[i][i]);
+  return sum + comp;
 }
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix result(*this);
+
+template <typename T>
+T S21BasicMatrix<T>::Norm(S21Norm kind) const {
+  // The one and infinity norms trade places on the stored array.
+  if (ColMajor() && kind == S21Norm::kOne)
+    kind = S21Norm::kInf;
+  else if (ColMajor() && kind == S21Norm::kInf)
+    kind = S21Norm::kOne;
+  if (kind == S21Norm::kOne) {
+    std::vector<T> sums(cols_);
+    ColumnSums(Rows(), rows_, cols_, [](T x) { return std::abs(x); },
+               sums.data());
+    return *std::max_element(sums.begin(), sums.end());
+  }
+  if (kind == S21Norm::kFrobenius)
+    return std::sqrt(SumRows<T>(rows_, cols_, [this](int i) {
+      return PairwiseSum(Rows()[i], cols_, [](T x) { return x * x; });
+    }));
+  std::vector<T> partial(rows_);
+  ForRowChunks(rows_, cols_, [&](int, int i0, int i1) {
+    for (int i = i0; i < i1; i++) {
+      const T* row = Rows()[i];
+      if (kind == S21Norm::kInf)
+        partial[i] = PairwiseSum(row, cols_, [](T x) { return std::abs(x); });
+      else
+        for (int j = 0; j < cols_; j++)
+          partial[i] = std::max(partial[i], std::abs(row[j]));
+    }
+  });
+  return *std::max_element(partial.begin(), partial.end());
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Min() const {
+  T res = Rows()[0][0];
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) res = std::min(res, Rows()[i][j]);
+  return res;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Max() const {
+  T res = Rows()[0][0];
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) res = std::max(res, Rows()[i][j]);
+  return res;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::Dot(const S21BasicMatrix<T>& other) const {
+  if (!SameSize(other))
+    throw std::logic_error("Matrices must be the same size");
+  if (layout_ == other.layout_)
+    return SumRows<T>(rows_, cols_, [&](int i) {
+      return PairwiseDot(Rows()[i], other.Rows()[i], cols_);
+    });
+  std::vector<T> partial(rows_);
+  ForRowPairs(other, [&](int i, const T* b) {
+    partial[i] = PairwiseDot(Rows()[i], b, cols_);
+    return true;
+  });
+  return PairwiseSum(partial.data(), rows_, [](T x) { return x; });
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::RowSums() const {
+  if (!ColMajor()) return StoredRowSums();
+  S21BasicMatrix<T> res = StoredColSums();
+  res.layout_ = S21Layout::kColMajor;
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::ColSums() const {
+  if (!ColMajor()) return StoredColSums();
+  S21BasicMatrix<T> res = StoredRowSums();
+  res.layout_ = S21Layout::kColMajor;
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::StoredRowSums() const {
+  S21BasicMatrix<T> res(rows_, 1, kUninitialized);
+  auto out = res.Rows();
+  ForRowChunks(rows_, cols_, [&](int, int i0, int i1) {
+    for (int i = i0; i < i1; i++)
+      out[i][0] = PairwiseSum(Rows()[i], cols_, [](T x) { return x; });
+  });
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::StoredColSums() const {
+  S21BasicMatrix<T> res(1, cols_, kUninitialized);
+  ColumnSums(Rows(), rows_, cols_, [](T x) { return x; }, res.Rows()[0]);
+  return res;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Hadamard(const S21BasicMatrix<T>& other) {
+  if (!SameSize(other))
+    throw std::logic_error("Matrices must be the same size");
+  Detach();
+  ForRowPairs(other, [this](int i, const T* b) {
+    T* a = Rows()[i];
+    for (int j = 0; j < cols_; j++) a[j] *= b[j];
+    return true;
+  });
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::SumMatrixAsync(
+    future_type a, future_type b) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        S21BasicMatrix<T> res(x);
+        res.SumMatrix(y);
+        return res;
+      },
+      a, b);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::SubMatrixAsync(
+    future_type a, future_type b) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        S21BasicMatrix<T> res(x);
+        res.SubMatrix(y);
+        return res;
+      },
+      a, b);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::MulNumberAsync(
+    future_type a, const T num) {
+  return S21Async::When(
+      [num](const S21BasicMatrix<T>& x) {
+        S21BasicMatrix<T> res(x);
+        res.MulNumber(num);
+        return res;
+      },
+      a);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::MulMatrixAsync(
+    future_type a, future_type b) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x, const S21BasicMatrix<T>& y) {
+        S21BasicMatrix<T> res = Scratch(x.GetRows(), y.GetCols(), x.layout_);
+        Gemm(1, x, false, y, false, 0, res);
+        return res;
+      },
+      a, b);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::TransposeAsync(
+    future_type a) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x) { return x.Transpose(); }, a);
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::future_type S21BasicMatrix<T>::InverseMatrixAsync(
+    future_type a) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x) { return x.InverseMatrix(); }, a);
+}
+
+template <typename T>
+S21Future<T> S21BasicMatrix<T>::DeterminantAsync(future_type a) {
+  return S21Async::When(
+      [](const S21BasicMatrix<T>& x) { return x.Determinant(); }, a);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator+(
+    const S21BasicMatrix<T>& other) const {
+  S21BasicMatrix<T> result(*this);
   result.SumMatrix(other);
   return result;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix result(*this);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator-(
+    const S21BasicMatrix<T>& other) const {
+  S21BasicMatrix<T> result(*this);
   result.SubMatrix(other);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix<T>& other) const {
+  if (GetCols() != other.GetRows())
+    throw std::logic_error(
+        "The columns of the first matrix must be equal to the rows of the "
+        "second matrix");
+  S21BasicMatrix<T> result = Scratch(GetRows(), other.GetCols(), layout_);
+  Gemm(1, *this, false, other, false, 0, result);
   return result;
 }
 
-S21Matrix S21Matrix::operator*(const double num) {
-  S21Matrix result(*this);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const T num) const {
+  S21BasicMatrix<T> result(*this);
   result.MulNumber(num);
   return result;
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix<T>& other) const {
   return EqMatrix(other);
 }
 
-S21Matrix S21Matrix::operator=(const S21Matrix& other) {
-  if (cols_ != other.cols_ || rows_ != other.rows_) {
-    if (matrix_) {
-      for (int i = 0; i < rows_; i++) delete[] matrix_[i];
-      delete[] matrix_;
-    }
-
-    matrix_ = new double* [other.rows_] {};
-    for (int i = 0; i < other.rows_; i++)
-      matrix_[i] = new double[other.cols_]{};
-    rows_ = other.rows_;
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    const S21BasicMatrix<T>& other) {
+  if (this == &other) return *this;
+  if (other.refs_ && !other.leaked_) {
+    S21_STATS_SCOPE(S21Op::kAssign, 0, 0, 0);
+    other.refs_->fetch_add(1, std::memory_order_relaxed);
+    Release();
     cols_ = other.cols_;
+    rows_ = other.rows_;
+    row_capacity_ = other.row_capacity_;
+    stride_ = other.stride_;
+    data_ = other.data_;
+    refs_ = other.refs_;
+    layout_ = other.layout_;
+    return *this;
+  }
+  const bool realloc = IsShared() || other.rows_ > row_capacity_ ||
+                       other.cols_ > stride_;
+  S21_STATS_SCOPE(S21Op::kAssign, 0,
+                  2ull * other.rows_ * other.cols_ * sizeof(T), realloc);
+  if (realloc) {
+    S21BasicMatrix<T> res(other.rows_, other.cols_, kUninitialized);
+    Adopt(res);
   }
+  leaked_ = false;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  layout_ = other.layout_;
   for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_; j++) (*this)(i, j) = other(i, j);
+    std::copy_n(other.Rows()[i], cols_, Rows()[i]);
   return *this;
 }
 
-void S21Matrix::operator+=(const S21Matrix& other) { SumMatrix(other); }
+template <typename T>
+void S21BasicMatrix<T>::operator+=(const S21BasicMatrix<T>& other) {
+  SumMatrix(other);
+}
 
-void S21Matrix::operator-=(const S21Matrix& other) { SubMatrix(other); }
+template <typename T>
+void S21BasicMatrix<T>::operator-=(const S21BasicMatrix<T>& other) {
+  SubMatrix(other);
+}
 
-void S21Matrix::operator*=(const S21Matrix& other) { MulMatrix(other); }
+template <typename T>
+void S21BasicMatrix<T>::operator*=(const S21BasicMatrix<T>& other) {
+  MulMatrix(other);
+}
 
-void S21Matrix::operator*=(const double num) { MulNumber(num); }
+template <typename T>
+void S21BasicMatrix<T>::operator*=(const T num) { MulNumber(num); }
 
-double& S21Matrix::operator()(int i, int j) {
-  if (i < 0 || j < 0 || i >= rows_ || j >= cols_)
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
+  if (i < 0 || j < 0 || i >= GetRows() || j >= GetCols())
     throw std::out_of_range("Out of range");
-  return matrix_[i][j];
+  Detach();
+  leaked_ = true;
+  return ColMajor() ? Rows()[j][i] : Rows()[i][j];
 }
-double& S21Matrix::operator()(int i, int j) const {
-  if (i < 0 || j < 0 || i >= rows_ || j >= cols_)
+template <typename T>
+const T& S21BasicMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || j < 0 || i >= GetRows() || j >= GetCols())
     throw std::out_of_range("Out of range");
-  return matrix_[i][j];
+  if (ColMajor()) std::swap(i, j);
+  return data_[static_cast<size_t>(i) * stride_ + j];
 }
 
-int S21Matrix::GetRows() const { return rows_; }
-int S21Matrix::GetCols() const { return cols_; }
-void S21Matrix::SetRows(int rows) {
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const {
+  return ColMajor() ? cols_ : rows_;
+}
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const {
+  return ColMajor() ? rows_ : cols_;
+}
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows < 1) throw std::out_of_range("Out of range");
-  S21Matrix new_matrix(rows, cols_);
-  for (int i = 0; i < rows_ && i < rows; i++)
-    for (int j = 0; j < cols_; j++) new_matrix(i, j) = (*this)(i, j);
-  *this = new_matrix;
+  if (ColMajor())
+    ResizeCols(rows);
+  else
+    ResizeRows(rows);
 }
-void S21Matrix::SetCols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols < 1) throw std::out_of_range("Out of range");
-  S21Matrix new_matrix(rows_, cols);
-  for (int i = 0; i < rows_; i++)
-    for (int j = 0; j < cols_ && j < cols; j++)
-      new_matrix(i, j) = (*this)(i, j);
-  *this = new_matrix;
+  if (ColMajor())
+    ResizeRows(cols);
+  else
+    ResizeCols(cols);
+}
+template <typename T>
+void S21BasicMatrix<T>::ResizeRows(int rows) {
+  S21_STATS_SCOPE(S21Op::kSetRows, 0,
+                  1ull * std::max(rows - rows_, 0) * cols_ * sizeof(T), 0);
+  if (rows > row_capacity_) {
+    Reallocate(std::max(rows, 2 * row_capacity_), stride_);
+  } else if (rows > rows_) {
+    Detach();
+    for (int i = rows_; i < rows; i++) std::fill_n(Rows()[i], cols_, T(0));
+  }
+  rows_ = rows;
+}
+template <typename T>
+void S21BasicMatrix<T>::ResizeCols(int cols) {
+  S21_STATS_SCOPE(S21Op::kSetCols, 0,
+                  1ull * rows_ * std::max(cols - cols_, 0) * sizeof(T), 0);
+  if (cols > stride_) {
+    Reallocate(row_capacity_, std::max(cols, 2 * stride_));
+  } else if (cols > cols_) {
+    Detach();
+    for (int i = 0; i < rows_; i++)
+      std::fill_n(Rows()[i] + cols_, cols - cols_, T(0));
+  }
+  cols_ = cols;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 1 || cols < 1) throw std::out_of_range("Out of range");
+  if (ColMajor()) std::swap(rows, cols);
+  if (rows > row_capacity_ || cols > stride_)
+    Reallocate(std::max(rows, row_capacity_), std::max(cols, stride_));
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const S21BasicMatrix<T>& row) {
+  if (row.GetRows() != 1 || row.GetCols() != GetCols())
+    throw std::logic_error("The row must be a 1 x cols matrix");
+  if (ColMajor()) {
+    ResizeCols(cols_ + 1);
+    for (int j = 0; j < rows_; j++) Rows()[j][cols_ - 1] = row(0, j);
+    return;
+  }
+  S21_STATS_SCOPE(S21Op::kSetRows, 0, 2ull * cols_ * sizeof(T), 0);
+  if (rows_ == row_capacity_)
+    Reallocate(std::max(1, 2 * row_capacity_), stride_);
+  else
+    Detach();
+  for (int j = 0; j < cols_; j++) Rows()[rows_][j] = row(0, j);
+  rows_++;
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRowsCapacity() const {
+  return ColMajor() ? stride_ : row_capacity_;
+}
+template <typename T>
+int S21BasicMatrix<T>::GetColsCapacity() const {
+  return ColMajor() ? row_capacity_ : stride_;
 }
 
-S21Matrix S21Matrix::GetMinor(int row, int col) {
-  S21Matrix minor(rows_ - 1, cols_ - 1);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::GetMinor(int row, int col) const {
+  S21_STATS_SCOPE(S21Op::kGetMinor, 0, 2ull * rows_ * cols_ * sizeof(T), 0);
+  S21BasicMatrix<T> minor(GetRows() - 1, GetCols() - 1, kUninitialized);
   int i = 0, j = 0;
-  for (int ki = 0; ki < rows_; ki++)
-    for (int kj = 0; kj < cols_; kj++) {
+  for (int ki = 0; ki < GetRows(); ki++)
+    for (int kj = 0; kj < GetCols(); kj++) {
       if (ki != row && col != kj) {
         minor(i, j) = (*this)(ki, kj);
         j++;
-        if (j == cols_ - 1) {
+        if (j == GetCols() - 1) {
           j = 0;
           i++;
         }
@@ -247,12 +1303,17 @@ S21Matrix S21Matrix::GetMinor(int row, int col) {
     }
   return minor;
 }
-void S21Matrix::print() {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      std::cout << matrix_[i * cols_ + j] << ' ';
+template <typename T>
+void S21BasicMatrix<T>::print() const {
+  for (int i = 0; i < GetRows(); i++) {
+    for (int j = 0; j < GetCols(); j++) {
+      std::cout << (*this)(i, j) << ' ';
     }
     std::cout << "\n";
   }
   std::cout << "\n";
 }
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
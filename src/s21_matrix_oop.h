@@ -1,48 +1,290 @@
+#ifndef S21_MATRIX_OOP_H_
+#define S21_MATRIX_OOP_H_
+
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iostream>
-class S21Matrix {
+#include <limits>
+
+#include "s21_matrix_async.h"
+
+enum class S21Norm { kOne, kInf, kFrobenius, kMax };
+
+// Storage order of the elements. A column-major matrix keeps its transpose
+// in row-major order, so flipping the layout transposes without moving data.
+enum class S21Layout { kRowMajor, kColMajor };
+
+template <typename T>
+struct S21Tolerance {
+  enum class Kind { kAbsolute, kRelative, kUlp, kNorm };
+
+  // |a - b| <= value for every element.
+  static constexpr S21Tolerance Absolute(T value) {
+    return {Kind::kAbsolute, value};
+  }
+  // |a - b| <= value * max(|a|, |b|) for every element.
+  static constexpr S21Tolerance Relative(T value) {
+    return {Kind::kRelative, value};
+  }
+  // |a - b| is at most `value` units in the last place of max(|a|, |b|).
+  static constexpr S21Tolerance Ulp(T value) { return {Kind::kUlp, value}; }
+  // ||A - B||_F <= value * ||A||_F.
+  static constexpr S21Tolerance Norm(T value) { return {Kind::kNorm, value}; }
+
+  Kind kind;
+  T value;
+};
+
+template <typename T>
+struct S21Comparison {
+  bool equal;
+  // Position of the largest elementwise error, -1 if there is none.
+  int row;
+  int col;
+  // Largest error in the units of the policy; the norm ratio for kNorm.
+  T max_error;
+};
+
+// Const members may run concurrently on one matrix from any number of
+// threads; the non-const ones need exclusive use of it. Copy-on-write copies
+// are separate matrices, so each thread may modify its own copy while they
+// still share a buffer.
+template <typename T>
+class S21BasicMatrix {
  public:
-  S21Matrix() noexcept;
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other) noexcept;
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix() noexcept;
-
-  bool EqMatrix(const S21Matrix& other) const;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num) noexcept;
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
-
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double num);
-  bool operator==(const S21Matrix& other) const;
-  S21Matrix operator=(const S21Matrix& other);
-  void operator+=(const S21Matrix& other);
-  void operator-=(const S21Matrix& other);
-  void operator*=(const S21Matrix& other);
-  void operator*=(const double num);
-
-  double& operator()(int i, int j);
-  double& operator()(int i, int j) const;
+  using value_type = T;
+  using future_type = S21Future<S21BasicMatrix>;
+
+  struct UninitializedTag {};
+  static constexpr UninitializedTag kUninitialized{};
+
+  S21BasicMatrix() noexcept;
+  S21BasicMatrix(int rows, int cols);
+  // Leaves the elements unset, for matrices that are fully overwritten.
+  // Large ones then get their pages from the first kernel that writes them.
+  S21BasicMatrix(int rows, int cols, UninitializedTag);
+  S21BasicMatrix(int rows, int cols, T fill);
+  S21BasicMatrix(int rows, int cols, S21Layout layout);
+  S21BasicMatrix(const S21BasicMatrix& other) noexcept;
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  template <typename U>
+  explicit S21BasicMatrix(const S21BasicMatrix<U>& other);
+  ~S21BasicMatrix() noexcept;
+
+  static S21BasicMatrix Identity(int n);
+
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  bool EqMatrix(const S21BasicMatrix& other,
+                const S21Tolerance<T>& tolerance) const;
+  S21Comparison<T> Compare(const S21BasicMatrix& other,
+                           const S21Tolerance<T>& tolerance) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num) noexcept;
+  void MulMatrix(const S21BasicMatrix& other);
+  // c = alpha * op(a) * op(b) + beta * c, where op transposes when asked.
+  // c must already have the result size and must not alias a or b. Bands
+  // of c rows run on the S21Scheduler pool; nothing is allocated per call.
+  static void Gemm(const T alpha, const S21BasicMatrix& a, bool trans_a,
+                   const S21BasicMatrix& b, bool trans_b, const T beta,
+                   S21BasicMatrix& c);
+  // Shares or copies the storage and flips the layout; no element moves.
+  S21BasicMatrix Transpose() const;
+  S21BasicMatrix CalcComplements() const;
+  T Determinant() const;
+  S21BasicMatrix InverseMatrix() const;
+  // Factors a float copy and refines the result in T precision. Falls back
+  // to InverseMatrix when the refined residual stays above sqrt(epsilon).
+  S21BasicMatrix InverseMatrixMixed() const;
+  // A^k by repeated squaring in ping-pong buffers: about 2 * log2(k)
+  // products and no allocation per step. Negative k powers the inverse.
+  S21BasicMatrix Power(int k) const;
+  // e^A by scaling and squaring with a Pade approximant of degree 3 to 13.
+  S21BasicMatrix Exp() const;
+  // Numerical rank by QR with column pivoting, which stops at the first
+  // pivot below tol times the largest column norm. A negative tol uses
+  // max(rows, cols) * epsilon.
+  int Rank(T tol = -1) const;
+  // Orthonormal basis of the null space in the columns; throws if the
+  // columns are independent.
+  S21BasicMatrix NullSpace(T tol = -1) const;
+  // A zero row or column answers without factoring.
+  bool IsSingular(T tol = -1) const;
+
+  // Sums are pairwise along rows and compensated down columns; large
+  // matrices are reduced in parallel over fixed row chunks.
+  T Trace() const;
+  T Norm(S21Norm kind = S21Norm::kFrobenius) const;
+  T Min() const;
+  T Max() const;
+  T Dot(const S21BasicMatrix& other) const;
+  S21BasicMatrix RowSums() const;
+  S21BasicMatrix ColSums() const;
+  void Hadamard(const S21BasicMatrix& other);
+  template <typename F>
+  void Apply(F f);
+
+  // Asynchronous variants run on S21Scheduler once their inputs are ready.
+  // A matrix argument is copied, which is cheap for copy-on-write ones.
+  static future_type SumMatrixAsync(future_type a, future_type b);
+  static future_type SubMatrixAsync(future_type a, future_type b);
+  static future_type MulNumberAsync(future_type a, const T num);
+  static future_type MulMatrixAsync(future_type a, future_type b);
+  static future_type TransposeAsync(future_type a);
+  static future_type InverseMatrixAsync(future_type a);
+  static S21Future<T> DeterminantAsync(future_type a);
+
+  S21BasicMatrix operator+(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator-(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  S21BasicMatrix operator*(const T num) const;
+  bool operator==(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  void operator+=(const S21BasicMatrix& other);
+  void operator-=(const S21BasicMatrix& other);
+  void operator*=(const S21BasicMatrix& other);
+  void operator*=(const T num);
+
+  T& operator()(int i, int j);
+  const T& operator()(int i, int j) const;
 
   int GetRows() const;
   int GetCols() const;
   void SetRows(int rows);
   void SetCols(int cols);
+  // Capacity management: shrinking keeps the buffer, growing past the
+  // capacity at least doubles it, so repeated AppendRow is amortized O(cols).
+  void Reserve(int rows, int cols);
+  void AppendRow(const S21BasicMatrix& row);
+  int GetRowsCapacity() const;
+  int GetColsCapacity() const;
+
+  S21Layout GetLayout() const noexcept;
+  // Reorders the storage, keeping the elements' logical positions.
+  void SetLayout(S21Layout layout);
 
-  void print();
+  // Copies of a copy-on-write matrix share its buffer until one of them is
+  // modified through a mutating method or the non-const operator(). A
+  // reference from the non-const operator() stays valid until the next call
+  // of another non-const member; until then copies get their own buffer,
+  // so writes through the reference never reach them.
+  void SetCopyOnWrite(bool enabled);
+  bool IsCopyOnWrite() const noexcept;
+  bool IsShared() const noexcept;
+
+  void print() const;
+
+  static constexpr T eps =
+      std::max(T(1e-7), T(1000) * std::numeric_limits<T>::epsilon());
 
  private:
-  S21Matrix GetMinor(int row, int col);
+  template <typename>
+  friend class S21BasicMatrix;
+  template <typename>
+  friend class S21LU;
+  template <typename>
+  friend class S21Cholesky;
+  template <typename>
+  friend class S21QR;
+  template <typename>
+  friend class S21PivotedQR;
+  template <typename>
+  friend class S21SymmetricEigen;
+  template <typename>
+  friend class S21Eigen;
+  template <typename>
+  friend class S21SVD;
+
+  template <typename P>
+  struct RowView {
+    P* data;
+    int stride;
+    P* operator[](int i) const {
+      return data + static_cast<size_t>(i) * stride;
+    }
+  };
+
+  // Raw row access for kernels. Writers must call Detach() first.
+  RowView<T> Rows() noexcept { return {data_, stride_}; }
+  RowView<const T> Rows() const noexcept { return {data_, stride_}; }
+  bool ColMajor() const noexcept { return layout_ == S21Layout::kColMajor; }
+  bool SameSize(const S21BasicMatrix& other) const noexcept;
+  // The stored array as a row-major matrix: A, or A^T if column-major.
+  S21BasicMatrix Stored() const;
+  // Calls body(i, b) for each stored row i, where b holds the matching
+  // elements of other in this matrix's order; stops when body is false.
+  template <typename Body>
+  bool ForRowPairs(const S21BasicMatrix& other, Body body) const;
+  static void GemmKernel(const T alpha, const S21BasicMatrix& a, bool trans_a,
+                         const S21BasicMatrix& b, bool trans_b, const T beta,
+                         S21BasicMatrix& c);
+  // A matrix of the given logical size and layout with unset elements.
+  static S21BasicMatrix Scratch(int rows, int cols, S21Layout layout);
+  S21BasicMatrix StoredRowSums() const;
+  S21BasicMatrix StoredColSums() const;
+  void ResizeRows(int rows);
+  void ResizeCols(int cols);
+  // Buffers of kLargeBuffer bytes or more are mapped directly, on huge pages
+  // where the system allows. Mapped pages read as zero, so they need no
+  // zeroing. No NUMA placement is done: pages land wherever the kernel's
+  // default policy puts them.
+  static constexpr size_t kLargeBuffer = size_t(2) << 20;
+  static T* NewBuffer(size_t size, bool zero);
+  static void DeleteBuffer(T* data, size_t size) noexcept;
+  // Runs body(i0, i1) over bands of `rows` rows of a buffer of `size`
+  // elements, in parallel if the buffer is large.
+  template <typename Body>
+  static void ForRowBands(int rows, int stride, size_t size, Body body);
+  void Allocate(int rows, int cols, bool zero = true);
+  void Reallocate(int row_capacity, int col_capacity);
+  void Release() noexcept;
+  void Detach();
+  void Swap(S21BasicMatrix& other) noexcept;
+  // Takes over other's storage, keeping this matrix's copy-on-write mode.
+  void Adopt(S21BasicMatrix& other);
+
+  S21BasicMatrix GetMinor(int row, int col) const;
+  // Shape of the stored array; swapped against GetRows/GetCols when
+  // column-major.
   int cols_;
   int rows_;
-  double** matrix_;
-  const double eps = 1e-7;
-};
\ No newline at end of file
+  int row_capacity_;
+  int stride_;
+  T* data_;
+  // Shared owner count; only copy-on-write matrices have one.
+  std::atomic<int>* refs_;
+  S21Layout layout_ = S21Layout::kRowMajor;
+  // Set by the non-const operator(), whose reference may be held outside,
+  // and cleared by the next writer; while set the buffer is never shared.
+  bool leaked_ = false;
+};
+
+template <typename T>
+template <typename U>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U>& other)
+    : S21BasicMatrix(other.rows_, other.cols_, kUninitialized) {
+  layout_ = other.layout_;
+  for (int i = 0; i < rows_; i++)
+    for (int j = 0; j < cols_; j++) Rows()[i][j] = T(other.Rows()[i][j]);
+}
+
+template <typename T>
+template <typename F>
+void S21BasicMatrix<T>::Apply(F f) {
+  Detach();
+  for (int i = 0; i < rows_; i++) {
+    T* row = Rows()[i];
+    for (int j = 0; j < cols_; j++) row[j] = f(row[j]);
+  }
+}
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+#endif  // S21_MATRIX_OOP_H_
@@ -0,0 +1,244 @@
+#include "s21_matrix_qr.h"
+
+template <typename T>
+S21QR<T>::S21QR(const S21BasicMatrix<T>& a)
+    : qr_(a), tau_(a.GetCols()), rank_deficient_(false) {
+  qr_.SetLayout(S21Layout::kRowMajor);
+  const int m = qr_.rows_, n = qr_.cols_;
+  if (m < n)
+    throw std::logic_error(
+        "The matrix must have at least as many rows as columns");
+  qr_.Detach();
+  auto q = qr_.Rows();
+  T scale = 0;
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < n; j++) scale = std::max(scale, std::abs(q[i][j]));
+  const T tol = m * std::numeric_limits<T>::epsilon() * scale;
+
+  std::vector<T> w(n);
+  for (int k = 0; k < n; k++) {
+    T sigma = 0;
+    for (int i = k + 1; i < m; i++) sigma += q[i][k] * q[i][k];
+    tau_[k] = 0;
+    if (sigma != 0) {
+      const T x0 = q[k][k];
+      const T norm = std::sqrt(x0 * x0 + sigma);
+      const T beta = x0 > 0 ? -norm : norm;
+      const T v0 = x0 - beta;
+      tau_[k] = (beta - x0) / beta;
+      for (int i = k + 1; i < m; i++) q[i][k] /= v0;
+      q[k][k] = beta;
+
+      for (int j = k + 1; j < n; j++) w[j] = q[k][j];
+      for (int i = k + 1; i < m; i++) {
+        const T v = q[i][k];
+        for (int j = k + 1; j < n; j++) w[j] += v * q[i][j];
+      }
+      for (int j = k + 1; j < n; j++) q[k][j] -= tau_[k] * w[j];
+      for (int i = k + 1; i < m; i++) {
+        const T tv = tau_[k] * q[i][k];
+        for (int j = k + 1; j < n; j++) q[i][j] -= tv * w[j];
+      }
+    }
+    if (std::abs(q[k][k]) <= tol) rank_deficient_ = true;
+  }
+}
+
+template <typename T>
+bool S21QR<T>::IsRankDeficient() const noexcept {
+  return rank_deficient_;
+}
+
+template <typename T>
+T S21QR<T>::Determinant() const {
+  if (qr_.rows_ != qr_.cols_)
+    throw std::logic_error("The matrix must be square");
+  T det = 1;
+  for (int k = 0; k < qr_.cols_; k++) {
+    det *= qr_.Rows()[k][k];
+    if (tau_[k] != 0) det = -det;
+  }
+  return det;
+}
+
+template <typename T>
+T S21QR<T>::LogDeterminant() const {
+  if (qr_.rows_ != qr_.cols_)
+    throw std::logic_error("The matrix must be square");
+  T sum = 0;
+  for (int k = 0; k < qr_.cols_; k++)
+    sum += std::log(std::abs(qr_.Rows()[k][k]));
+  return sum;
+}
+
+template <typename T>
+void S21QR<T>::ApplyQt(S21BasicMatrix<T>& b) const {
+  const int m = qr_.rows_, r = b.cols_;
+  b.Detach();
+  auto q = qr_.Rows();
+  auto x = b.Rows();
+  std::vector<T> w(r);
+  for (int k = 0; k < qr_.cols_; k++) {
+    if (tau_[k] == 0) continue;
+    for (int j = 0; j < r; j++) w[j] = x[k][j];
+    for (int i = k + 1; i < m; i++)
+      for (int j = 0; j < r; j++) w[j] += q[i][k] * x[i][j];
+    for (int j = 0; j < r; j++) x[k][j] -= tau_[k] * w[j];
+    for (int i = k + 1; i < m; i++) {
+      const T tv = tau_[k] * q[i][k];
+      for (int j = 0; j < r; j++) x[i][j] -= tv * w[j];
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21QR<T>::Solve(const S21BasicMatrix<T>& b) const {
+  const int n = qr_.cols_;
+  if (b.GetRows() != qr_.rows_)
+    throw std::logic_error("The right-hand side must have as many rows as A");
+  if (rank_deficient_) throw std::logic_error("The matrix is rank deficient");
+  S21BasicMatrix<T> y(b);
+  y.SetLayout(S21Layout::kRowMajor);
+  ApplyQt(y);
+  S21BasicMatrix<T> x(n, b.cols_, S21BasicMatrix<T>::kUninitialized);
+  auto q = qr_.Rows();
+  auto xr = x.Rows();
+  auto yr = y.Rows();
+  for (int i = n - 1; i >= 0; i--) {
+    for (int j = 0; j < b.cols_; j++) xr[i][j] = yr[i][j];
+    for (int k = i + 1; k < n; k++)
+      for (int j = 0; j < b.cols_; j++) xr[i][j] -= q[i][k] * xr[k][j];
+    for (int j = 0; j < b.cols_; j++) xr[i][j] /= q[i][i];
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21QR<T>::Q() const {
+  const int m = qr_.rows_, n = qr_.cols_;
+  auto q = qr_.Rows();
+  S21BasicMatrix<T> res(m, n);
+  auto x = res.Rows();
+  for (int i = 0; i < n; i++) x[i][i] = 1;
+  std::vector<T> w(n);
+  for (int k = n - 1; k >= 0; k--) {
+    if (tau_[k] == 0) continue;
+    for (int j = 0; j < n; j++) w[j] = x[k][j];
+    for (int i = k + 1; i < m; i++)
+      for (int j = 0; j < n; j++) w[j] += q[i][k] * x[i][j];
+    for (int j = 0; j < n; j++) x[k][j] -= tau_[k] * w[j];
+    for (int i = k + 1; i < m; i++) {
+      const T tv = tau_[k] * q[i][k];
+      for (int j = 0; j < n; j++) x[i][j] -= tv * w[j];
+    }
+  }
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21QR<T>::R() const {
+  const int n = qr_.cols_;
+  S21BasicMatrix<T> res(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = i; j < n; j++) res.Rows()[i][j] = qr_.Rows()[i][j];
+  return res;
+}
+
+template <typename T>
+S21PivotedQR<T>::S21PivotedQR(const S21BasicMatrix<T>& a, T tol)
+    : qr_(a), perm_(a.GetCols()), rank_(0) {
+  qr_.SetLayout(S21Layout::kRowMajor);
+  qr_.Detach();
+  const int m = qr_.rows_, n = qr_.cols_;
+  if (tol < 0) tol = std::max(m, n) * std::numeric_limits<T>::epsilon();
+  auto q = qr_.Rows();
+  // Squared norms of the remaining parts of the columns, downdated after
+  // each step and recomputed once cancellation has eaten half the digits.
+  std::vector<T> norms(n), exact(n), w(n);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < n; j++) norms[j] += q[i][j] * q[i][j];
+  exact = norms;
+  for (int j = 0; j < n; j++) perm_[j] = j;
+  const T limit = tol * tol * *std::max_element(norms.begin(), norms.end());
+  const T recompute = std::sqrt(std::numeric_limits<T>::epsilon());
+
+  for (int k = 0; k < std::min(m, n); k++) {
+    const int p = static_cast<int>(
+        std::max_element(norms.begin() + k, norms.end()) - norms.begin());
+    if (norms[p] <= limit || norms[p] == 0) break;
+    if (p != k) {
+      for (int i = 0; i < m; i++) std::swap(q[i][k], q[i][p]);
+      std::swap(norms[k], norms[p]);
+      std::swap(exact[k], exact[p]);
+      std::swap(perm_[k], perm_[p]);
+    }
+    rank_++;
+
+    T sigma = 0;
+    for (int i = k + 1; i < m; i++) sigma += q[i][k] * q[i][k];
+    if (sigma != 0) {
+      const T x0 = q[k][k];
+      const T norm = std::sqrt(x0 * x0 + sigma);
+      const T beta = x0 > 0 ? -norm : norm;
+      const T v0 = x0 - beta;
+      const T tau = (beta - x0) / beta;
+      for (int i = k + 1; i < m; i++) q[i][k] /= v0;
+      q[k][k] = beta;
+
+      for (int j = k + 1; j < n; j++) w[j] = q[k][j];
+      for (int i = k + 1; i < m; i++) {
+        const T v = q[i][k];
+        for (int j = k + 1; j < n; j++) w[j] += v * q[i][j];
+      }
+      for (int j = k + 1; j < n; j++) q[k][j] -= tau * w[j];
+      for (int i = k + 1; i < m; i++) {
+        const T tv = tau * q[i][k];
+        for (int j = k + 1; j < n; j++) q[i][j] -= tv * w[j];
+      }
+    }
+    for (int j = k + 1; j < n; j++) {
+      norms[j] -= q[k][j] * q[k][j];
+      if (norms[j] > recompute * exact[j]) continue;
+      norms[j] = 0;
+      for (int i = k + 1; i < m; i++) norms[j] += q[i][j] * q[i][j];
+      exact[j] = norms[j];
+    }
+  }
+}
+
+template <typename T>
+int S21PivotedQR<T>::Rank() const noexcept {
+  return rank_;
+}
+
+template <typename T>
+const std::vector<int>& S21PivotedQR<T>::Permutation() const noexcept {
+  return perm_;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21PivotedQR<T>::NullSpace() const {
+  const int n = qr_.cols_, r = rank_;
+  if (r == n) throw std::logic_error("The matrix has full column rank");
+  // With A * P = Q * [R11 R12], the columns of P * [-R11^-1 * R12; I] span
+  // the null space; they are orthonormalized by a plain QR.
+  auto q = qr_.Rows();
+  S21BasicMatrix<T> basis(n, n - r);
+  auto x = basis.Rows();
+  for (int c = 0; c < n - r; c++) {
+    x[perm_[r + c]][c] = 1;
+    for (int i = r - 1; i >= 0; i--) {
+      T sum = q[i][r + c];
+      for (int k = i + 1; k < r; k++) sum += q[i][k] * x[perm_[k]][c];
+      x[perm_[i]][c] = -sum / q[i][i];
+    }
+  }
+  return S21QR<T>(basis).Q();
+}
+
+template class S21QR<float>;
+template class S21QR<double>;
+template class S21QR<long double>;
+template class S21PivotedQR<float>;
+template class S21PivotedQR<double>;
+template class S21PivotedQR<long double>;
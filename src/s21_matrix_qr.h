@@ -0,0 +1,62 @@
+#ifndef S21_MATRIX_QR_H_
+#define S21_MATRIX_QR_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Householder A = Q * R for an m x n matrix with m >= n.
+template <typename T>
+class S21QR {
+ public:
+  explicit S21QR(const S21BasicMatrix<T>& a);
+
+  bool IsRankDeficient() const noexcept;
+  // The signed product of the diagonal of R, not cut off at a tolerance.
+  T Determinant() const;
+  T LogDeterminant() const;
+  // Least squares solution of A * X = B, exact when A is square.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  S21BasicMatrix<T> Q() const;
+  S21BasicMatrix<T> R() const;
+
+ private:
+  void ApplyQt(S21BasicMatrix<T>& b) const;
+
+  S21BasicMatrix<T> qr_;
+  std::vector<T> tau_;
+  bool rank_deficient_;
+};
+
+// Householder A * P = Q * R with column pivoting, for any m x n matrix.
+// Each step takes the remaining column of largest norm, so the diagonal of
+// R decreases and the factorization stops at the first negligible pivot:
+// a rank-r matrix costs O(m * n * r).
+template <typename T>
+class S21PivotedQR {
+ public:
+  // A pivot counts if it exceeds tol times the largest column norm; a
+  // negative tol uses max(m, n) * epsilon.
+  explicit S21PivotedQR(const S21BasicMatrix<T>& a, T tol = -1);
+
+  int Rank() const noexcept;
+  // Orthonormal basis of {x : A * x = 0} in the columns. Throws if A has
+  // full column rank.
+  S21BasicMatrix<T> NullSpace() const;
+  // Column k of A * P is column Permutation()[k] of A.
+  const std::vector<int>& Permutation() const noexcept;
+
+ private:
+  S21BasicMatrix<T> qr_;
+  std::vector<int> perm_;
+  int rank_;
+};
+
+extern template class S21QR<float>;
+extern template class S21QR<double>;
+extern template class S21QR<long double>;
+extern template class S21PivotedQR<float>;
+extern template class S21PivotedQR<double>;
+extern template class S21PivotedQR<long double>;
+
+#endif  // S21_MATRIX_QR_H_
@@ -0,0 +1,174 @@
+#include "s21_matrix_stats.h"
+
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+constexpr int kOps = static_cast<int>(S21Op::kCount);
+
+struct AtomicOpStats {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> total_ns{0};
+  std::atomic<uint64_t> flops{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> allocations{0};
+  std::array<std::atomic<uint64_t>, S21OpStats::kBuckets> latency{};
+};
+
+struct ThreadStats {
+  std::array<AtomicOpStats, kOps> ops;
+  // The counters at the last Reset, guarded by the registry mutex. Reset
+  // never writes the counters themselves, which would race with their
+  // single writer.
+  S21StatsSnapshot base;
+};
+
+// Each counter has a single writer (its thread), so a relaxed load and
+// store is enough and keeps the hot path free of locked instructions.
+void Bump(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void Accumulate(S21StatsSnapshot& dst, const ThreadStats& src) {
+  for (int i = 0; i < kOps; i++) {
+    const AtomicOpStats& s = src.ops[i];
+    S21OpStats& d = dst.ops[i];
+    d.calls += s.calls.load(std::memory_order_relaxed);
+    d.total_ns += s.total_ns.load(std::memory_order_relaxed);
+    d.flops += s.flops.load(std::memory_order_relaxed);
+    d.bytes += s.bytes.load(std::memory_order_relaxed);
+    d.allocations += s.allocations.load(std::memory_order_relaxed);
+    for (int b = 0; b < S21OpStats::kBuckets; b++)
+      d.latency[b] += s.latency[b].load(std::memory_order_relaxed);
+  }
+}
+
+// Counts since the last Reset: the counters less their recorded base.
+void AccumulateSinceReset(S21StatsSnapshot& dst, const ThreadStats& src) {
+  Accumulate(dst, src);
+  for (int i = 0; i < kOps; i++) {
+    const S21OpStats& b = src.base.ops[i];
+    S21OpStats& d = dst.ops[i];
+    d.calls -= b.calls;
+    d.total_ns -= b.total_ns;
+    d.flops -= b.flops;
+    d.bytes -= b.bytes;
+    d.allocations -= b.allocations;
+    for (int k = 0; k < S21OpStats::kBuckets; k++) d.latency[k] -= b.latency[k];
+  }
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadStats*> live;
+  S21StatsSnapshot retired;
+};
+
+// Never destroyed: threads may still retire their counters during exit.
+Registry& GetRegistry() {
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+struct ThreadSlot {
+  ThreadStats stats;
+
+  ThreadSlot() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.live.push_back(&stats);
+  }
+  ~ThreadSlot() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    AccumulateSinceReset(registry.retired, stats);
+    for (auto it = registry.live.begin(); it != registry.live.end(); ++it)
+      if (*it == &stats) {
+        registry.live.erase(it);
+        break;
+      }
+  }
+};
+
+ThreadStats& LocalStats() {
+  thread_local ThreadSlot slot;
+  return slot.stats;
+}
+
+int LatencyBucket(uint64_t ns) {
+  int bucket = 0;
+  while (ns > 1 && bucket < S21OpStats::kBuckets - 1) {
+    ns >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+}  // namespace
+
+const S21OpStats& S21StatsSnapshot::operator[](S21Op op) const {
+  return ops[static_cast<int>(op)];
+}
+
+std::string S21StatsSnapshot::ToJson() const {
+  std::ostringstream out;
+  out << '{';
+  for (int i = 0; i < kOps; i++) {
+    const S21OpStats& s = ops[i];
+    if (i) out << ',';
+    out << '"' << S21Stats::OpName(static_cast<S21Op>(i)) << "\":{"
+        << "\"calls\":" << s.calls << ",\"total_ns\":" << s.total_ns
+        << ",\"flops\":" << s.flops << ",\"bytes\":" << s.bytes
+        << ",\"allocations\":" << s.allocations << ",\"latency_ns_log2\":[";
+    for (int b = 0; b < S21OpStats::kBuckets; b++)
+      out << (b ? "," : "") << s.latency[b];
+    out << "]}";
+  }
+  out << '}';
+  return out.str();
+}
+
+const char* S21Stats::OpName(S21Op op) {
+  static const char* const kNames[kOps] = {
+      "Construct",   "Copy",      "Move",      "Assign",
+      "SumMatrix",   "SubMatrix", "MulNumber", "MulMatrix",
+      "Gemm",        "Transpose", "CalcComplements",
+      "Determinant", "InverseMatrix", "GetMinor", "SetRows",
+      "SetCols"};
+  int i = static_cast<int>(op);
+  return i >= 0 && i < kOps ? kNames[i] : "Unknown";
+}
+
+S21StatsSnapshot S21Stats::Snapshot() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  S21StatsSnapshot snapshot = registry.retired;
+  for (const ThreadStats* stats : registry.live)
+    AccumulateSinceReset(snapshot, *stats);
+  return snapshot;
+}
+
+void S21Stats::Reset() {
+  Registry& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.retired = S21StatsSnapshot();
+  for (ThreadStats* stats : registry.live) {
+    stats->base = S21StatsSnapshot();
+    Accumulate(stats->base, *stats);
+  }
+}
+
+void S21Stats::Record(S21Op op, uint64_t ns, uint64_t flops, uint64_t bytes,
+                      uint64_t allocations) noexcept {
+  AtomicOpStats& s = LocalStats().ops[static_cast<int>(op)];
+  Bump(s.calls, 1);
+  Bump(s.total_ns, ns);
+  Bump(s.flops, flops);
+  Bump(s.bytes, bytes);
+  Bump(s.allocations, allocations);
+  Bump(s.latency[LatencyBucket(ns)], 1);
+}
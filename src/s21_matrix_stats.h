@@ -0,0 +1,111 @@
+#ifndef S21_MATRIX_STATS_H_
+#define S21_MATRIX_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Build the library with -DS21_MATRIX_STATS to record per-operation
+// telemetry. Without it the recording macros expand to nothing and
+// snapshots stay empty. Every operation records only its own work: nested
+// calls and the constructors it uses are reported under their own entries.
+
+enum class S21Op {
+  kConstruct,
+  kCopy,
+  kMove,
+  kAssign,
+  kSum,
+  kSub,
+  kMulNumber,
+  kMulMatrix,
+  kGemm,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverse,
+  kGetMinor,
+  kSetRows,
+  kSetCols,
+  kCount
+};
+
+struct S21OpStats {
+  static constexpr int kBuckets = 32;
+
+  uint64_t calls = 0;
+  uint64_t total_ns = 0;
+  uint64_t flops = 0;
+  uint64_t bytes = 0;
+  uint64_t allocations = 0;
+  // Bucket b counts calls that took [2^b, 2^(b+1)) nanoseconds.
+  std::array<uint64_t, kBuckets> latency = {};
+};
+
+struct S21StatsSnapshot {
+  std::array<S21OpStats, static_cast<int>(S21Op::kCount)> ops = {};
+
+  const S21OpStats& operator[](S21Op op) const;
+  std::string ToJson() const;
+};
+
+class S21Stats {
+ public:
+  static constexpr bool Enabled() {
+#ifdef S21_MATRIX_STATS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static const char* OpName(S21Op op);
+  static S21StatsSnapshot Snapshot();
+  // May run while other threads record; their later counts are kept.
+  static void Reset();
+  static void Record(S21Op op, uint64_t ns, uint64_t flops, uint64_t bytes,
+                     uint64_t allocations) noexcept;
+};
+
+class S21StatsScope {
+ public:
+  S21StatsScope(S21Op op, uint64_t flops, uint64_t bytes,
+                uint64_t allocations) noexcept
+      : op_(op),
+        flops_(flops),
+        bytes_(bytes),
+        allocations_(allocations),
+        start_(std::chrono::steady_clock::now()) {}
+  S21StatsScope(const S21StatsScope&) = delete;
+  S21StatsScope& operator=(const S21StatsScope&) = delete;
+  ~S21StatsScope() {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start_)
+                  .count();
+    S21Stats::Record(op_, ns, flops_, bytes_, allocations_);
+  }
+
+ private:
+  S21Op op_;
+  uint64_t flops_;
+  uint64_t bytes_;
+  uint64_t allocations_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#define S21_STATS_CONCAT_(a, b) a##b
+#define S21_STATS_NAME_(line) S21_STATS_CONCAT_(s21_stats_scope_, line)
+
+#ifdef S21_MATRIX_STATS
+#define S21_STATS_SCOPE(op, flops, bytes, allocations)                 \
+  S21StatsScope S21_STATS_NAME_(__LINE__)(                             \
+      op, static_cast<uint64_t>(flops), static_cast<uint64_t>(bytes), \
+      static_cast<uint64_t>(allocations))
+#else
+#define S21_STATS_SCOPE(op, flops, bytes, allocations) \
+  do {                                                 \
+  } while (0)
+#endif
+
+#endif  // S21_MATRIX_STATS_H_
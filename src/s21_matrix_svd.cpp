@@ -0,0 +1,156 @@
+#include "s21_matrix_svd.h"
+
+#include <numeric>
+#include <stdexcept>
+
+#include "s21_matrix_eigen.h"
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+template <typename T>
+S21SVD<T>::S21SVD(const S21BasicMatrix<T>& a, bool vectors)
+    : w_(a.GetRows() >= a.GetCols() ? Transposed(a) : a),
+      x_(vectors ? w_.GetRows() : 1, vectors ? w_.GetRows() : 1),
+      values_(w_.GetRows()),
+      tol_(w_.GetCols() * std::numeric_limits<T>::epsilon()),
+      transposed_(a.GetRows() >= a.GetCols()),
+      vectors_(vectors) {
+  w_.SetLayout(S21Layout::kRowMajor);
+  w_.Detach();
+  const int k = w_.rows_, len = w_.cols_;
+  for (int i = 0; i < k && vectors_; i++) x_.Rows()[i][i] = 1;
+
+  // Round-robin ordering: every round pairs each row with a different
+  // partner (one row sits out when k is odd) and k - 1 rounds cover all
+  // pairs once.
+  const int p = k + k % 2;
+  const int grain = S21Tuning::Get().parallel_grain;
+  std::vector<char> rotated(p / 2);
+  for (int sweep = 0;; sweep++) {
+    if (sweep == kMaxSweeps)
+      throw std::runtime_error("The SVD iteration did not converge");
+    bool changed = false;
+    for (int r = 0; r + 1 < p; r++) {
+      S21ParallelFor(0, p / 2, std::max(1, grain / len),
+                     [&](int t0, int t1) {
+                       for (int t = t0; t < t1; t++) {
+                         int i = t == 0 ? p - 1 : (r + t) % (p - 1);
+                         int j = (r - t + p - 1) % (p - 1);
+                         if (i > j) std::swap(i, j);
+                         rotated[t] = j < k && Rotate(i, j);
+                       }
+                     });
+      for (char c : rotated) changed |= c != 0;
+    }
+    if (!changed) break;
+  }
+
+  for (int i = 0; i < k; i++) {
+    const T* row = w_.Rows()[i];
+    T sum = 0;
+    for (int j = 0; j < len; j++) sum += row[j] * row[j];
+    values_[i] = std::sqrt(sum);
+  }
+  std::vector<int> order(k);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](int i, int j) { return values_[i] > values_[j]; });
+  std::vector<T> values(k);
+  S21BasicMatrix<T> w(k, len, S21BasicMatrix<T>::kUninitialized);
+  S21BasicMatrix<T> x(x_.rows_, x_.cols_, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < k; i++) {
+    values[i] = values_[order[i]];
+    std::copy_n(w_.Rows()[order[i]], len, w.Rows()[i]);
+    if (vectors_) std::copy_n(x_.Rows()[order[i]], k, x.Rows()[i]);
+  }
+  values_.swap(values);
+  w_.Swap(w);
+  if (vectors_) x_.Swap(x);
+}
+
+// Orthogonalizes rows i and j; returns false when they already are.
+template <typename T>
+bool S21SVD<T>::Rotate(int i, int j) {
+  const int len = w_.cols_;
+  T* wi = w_.Rows()[i];
+  T* wj = w_.Rows()[j];
+  T alpha = 0, beta = 0, gamma = 0;
+  for (int c = 0; c < len; c++) {
+    alpha += wi[c] * wi[c];
+    beta += wj[c] * wj[c];
+    gamma += wi[c] * wj[c];
+  }
+  if (alpha == 0 || beta == 0 ||
+      std::abs(gamma) <= tol_ * std::sqrt(alpha) * std::sqrt(beta))
+    return false;
+  const T zeta = (beta - alpha) / (2 * gamma);
+  const T t = (zeta < 0 ? -1 : 1) / (std::abs(zeta) + std::hypot(T(1), zeta));
+  const T cs = 1 / std::sqrt(1 + t * t), sn = cs * t;
+  auto rotate = [cs, sn](T* a, T* b, int count) {
+    for (int c = 0; c < count; c++) {
+      const T x = a[c];
+      a[c] = cs * x - sn * b[c];
+      b[c] = sn * x + cs * b[c];
+    }
+  };
+  rotate(wi, wj, len);
+  if (vectors_) rotate(x_.Rows()[i], x_.Rows()[j], x_.cols_);
+  return true;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::Transposed(const S21BasicMatrix<T>& m) {
+  if (m.ColMajor()) return m.Stored();
+  S21BasicMatrix<T> res(m.cols_, m.rows_, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < m.rows_; i++)
+    for (int j = 0; j < m.cols_; j++) res.Rows()[j][i] = m.Rows()[i][j];
+  return res;
+}
+
+// The rows of w_ divided by their singular values, as columns.
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::Scaled() const {
+  S21BasicMatrix<T> res(w_.cols_, w_.rows_);
+  for (int i = 0; i < w_.rows_; i++) {
+    if (values_[i] == 0) continue;
+    for (int j = 0; j < w_.cols_; j++)
+      res.Rows()[j][i] = w_.Rows()[i][j] / values_[i];
+  }
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::Values() const {
+  S21BasicMatrix<T> res(w_.rows_, 1, S21BasicMatrix<T>::kUninitialized);
+  for (int i = 0; i < w_.rows_; i++) res.Rows()[i][0] = values_[i];
+  return res;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::U() const {
+  if (!vectors_) throw std::logic_error("Singular vectors were not computed");
+  return transposed_ ? Scaled() : Transposed(x_);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::V() const {
+  if (!vectors_) throw std::logic_error("Singular vectors were not computed");
+  return transposed_ ? Transposed(x_) : Scaled();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21SVD<T>::Largest(const S21BasicMatrix<T>& a, int k) {
+  const bool tall = a.GetRows() >= a.GetCols();
+  const int size = tall ? a.GetCols() : a.GetRows();
+  if (k < 1 || k > size) throw std::out_of_range("Out of range");
+  S21BasicMatrix<T> gram(size, size, S21BasicMatrix<T>::kUninitialized);
+  S21BasicMatrix<T>::Gemm(1, a, tall, a, !tall, 0, gram);
+  S21BasicMatrix<T> res = S21SymmetricEigen<T>::Largest(gram, k);
+  for (int i = 0; i < k; i++)
+    res.Rows()[i][0] = std::sqrt(std::max(T(0), res.Rows()[i][0]));
+  return res;
+}
+
+template class S21SVD<float>;
+template class S21SVD<double>;
+template class S21SVD<long double>;
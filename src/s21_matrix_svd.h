@@ -0,0 +1,47 @@
+#ifndef S21_MATRIX_SVD_H_
+#define S21_MATRIX_SVD_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Thin A = U * diag(values) * V^T of an m x n matrix with k = min(m, n)
+// singular values, by one-sided Jacobi. Each sweep pairs rows round-robin,
+// so the rotations of a round are independent and run in parallel.
+template <typename T>
+class S21SVD {
+ public:
+  explicit S21SVD(const S21BasicMatrix<T>& a, bool vectors = true);
+
+  // Singular values in descending order as a k x 1 matrix.
+  S21BasicMatrix<T> Values() const;
+  // m x k and n x k; the columns of zero singular values are zero.
+  S21BasicMatrix<T> U() const;
+  S21BasicMatrix<T> V() const;
+  // The k largest singular values from the eigenvalues of the smaller Gram
+  // matrix. Much cheaper than the full decomposition, but values below
+  // sqrt(eps) times the largest one lose their relative accuracy.
+  static S21BasicMatrix<T> Largest(const S21BasicMatrix<T>& a, int k);
+
+ private:
+  static constexpr int kMaxSweeps = 60;
+
+  bool Rotate(int i, int j);
+  S21BasicMatrix<T> Scaled() const;
+  static S21BasicMatrix<T> Transposed(const S21BasicMatrix<T>& m);
+
+  // Rows of w_ are the columns of A (or of A^T when m < n) being
+  // orthogonalized; x_ accumulates the same rotations.
+  S21BasicMatrix<T> w_;
+  S21BasicMatrix<T> x_;
+  std::vector<T> values_;
+  T tol_;
+  bool transposed_;
+  bool vectors_;
+};
+
+extern template class S21SVD<float>;
+extern template class S21SVD<double>;
+extern template class S21SVD<long double>;
+
+#endif  // S21_MATRIX_SVD_H_
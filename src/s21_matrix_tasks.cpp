@@ -0,0 +1,257 @@
+#include "s21_matrix_tasks.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+std::atomic<int> S21Runtime::threads_{0};
+std::atomic<S21Determinism> S21Runtime::determinism_{
+    S21Determinism::kReproducible};
+thread_local int S21Runtime::scoped_ = -1;
+
+int S21Runtime::Threads() noexcept {
+  int threads = threads_.load(std::memory_order_relaxed);
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+void S21Runtime::SetThreads(int threads) {
+  if (threads < 0) throw std::out_of_range("Out of range");
+  threads_.store(threads, std::memory_order_relaxed);
+}
+
+S21Determinism S21Runtime::Determinism() noexcept {
+  if (scoped_ >= 0) return static_cast<S21Determinism>(scoped_);
+  return determinism_.load(std::memory_order_relaxed);
+}
+
+void S21Runtime::SetDeterminism(S21Determinism mode) noexcept {
+  determinism_.store(mode, std::memory_order_relaxed);
+}
+
+S21DeterminismScope::S21DeterminismScope(S21Determinism mode) noexcept
+    : previous_(S21Runtime::scoped_) {
+  S21Runtime::scoped_ = static_cast<int>(mode);
+}
+
+S21DeterminismScope::~S21DeterminismScope() {
+  S21Runtime::scoped_ = previous_;
+}
+
+int S21TaskGraph::Add(std::function<void()> task,
+                      std::initializer_list<int> deps) {
+  const int id = static_cast<int>(nodes_.size());
+  Node node;
+  node.task = std::move(task);
+  for (int dep : deps) {
+    if (dep < 0) continue;
+    if (dep >= id) throw std::logic_error("Dependency on a later task");
+    nodes_[dep].next.push_back(id);
+    node.deps++;
+  }
+  nodes_.push_back(std::move(node));
+  return id;
+}
+
+int S21TaskGraph::Size() const noexcept {
+  return static_cast<int>(nodes_.size());
+}
+
+void S21TaskGraph::Run(int threads) {
+  const int total = Size();
+  if (threads > total) threads = total;
+  if (threads <= 1) {
+    for (Node& node : nodes_) node.task();
+    return;
+  }
+
+  struct State {
+    std::vector<Node>& nodes;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<int> ready;
+    std::vector<int> pending;
+    std::exception_ptr error;
+    int finished = 0;
+  } state{nodes_, {}, {}, {}, std::vector<int>(total), {}, 0};
+  for (int i = 0; i < total; i++) {
+    state.pending[i] = nodes_[i].deps;
+    if (state.pending[i] == 0) state.ready.push_back(i);
+  }
+
+  // Each of the `threads` runs is one worker loop. The caller's loop alone
+  // finishes the graph if no worker is free to join it.
+  S21Scheduler::Parallel(
+      threads, threads,
+      [](void* context, int) {
+        State& s = *static_cast<State*>(context);
+        const int total = static_cast<int>(s.nodes.size());
+        std::unique_lock<std::mutex> lock(s.mutex);
+        while (true) {
+          s.cv.wait(lock, [&] {
+            return !s.ready.empty() || s.finished == total || s.error;
+          });
+          if (s.finished == total || s.error) break;
+          const int id = s.ready.back();
+          s.ready.pop_back();
+          lock.unlock();
+          std::exception_ptr failure;
+          try {
+            s.nodes[id].task();
+          } catch (...) {
+            failure = std::current_exception();
+          }
+          lock.lock();
+          if (failure) {
+            if (!s.error) s.error = failure;
+          } else {
+            s.finished++;
+            for (int next : s.nodes[id].next)
+              if (--s.pending[next] == 0) s.ready.push_back(next);
+          }
+          s.cv.notify_all();
+        }
+      },
+      &state);
+  if (state.error) std::rethrow_exception(state.error);
+}
+
+namespace {
+
+// A call of S21Scheduler::Parallel, on the caller's stack. Jobs are linked
+// into the pool while workers may join them.
+struct Job {
+  void (*run)(void*, int);
+  void* context;
+  int count;
+  int max_helpers;
+  std::atomic<int> next{0};
+  // Guarded by the pool mutex.
+  int helpers = 0;
+  std::exception_ptr error;
+  Job* link = nullptr;
+};
+
+class WorkerPool {
+ public:
+  explicit WorkerPool(int threads) { Grow(threads); }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  void Post(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  void Parallel(Job& job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Grow(job.max_helpers);
+      job.link = jobs_;
+      jobs_ = &job;
+    }
+    cv_.notify_all();
+    Drain(job);
+    std::unique_lock<std::mutex> lock(mutex_);
+    Job** link = &jobs_;
+    while (*link != &job) link = &(*link)->link;
+    *link = job.link;
+    done_.wait(lock, [&] { return job.helpers == 0; });
+  }
+
+  // Runs the unclaimed items of job on the calling thread.
+  void Drain(Job& job) {
+    for (int i; (i = job.next.fetch_add(1)) < job.count;) {
+      try {
+        job.run(job.context, i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!job.error) job.error = std::current_exception();
+        job.next.store(job.count);
+      }
+    }
+  }
+
+ private:
+  // Starts workers until there are at least `threads`; called locked.
+  void Grow(int threads) {
+    while (static_cast<int>(workers_.size()) < threads && !stop_)
+      workers_.emplace_back([this] { Work(); });
+  }
+
+  Job* Joinable() const {
+    for (Job* job = jobs_; job; job = job->link)
+      if (job->helpers < job->max_helpers && job->next.load() < job->count)
+        return job;
+    return nullptr;
+  }
+
+  // Helping a waiting caller comes before starting a queued task.
+  void Work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock,
+               [this] { return stop_ || !queue_.empty() || Joinable(); });
+      if (Job* job = Joinable()) {
+        job->helpers++;
+        lock.unlock();
+        Drain(*job);
+        lock.lock();
+        if (--job->helpers == 0) done_.notify_all();
+        continue;
+      }
+      if (queue_.empty()) break;
+      std::function<void()> task = std::move(queue_.front());
+      queue_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_;
+  std::deque<std::function<void()>> queue_;
+  Job* jobs_ = nullptr;
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+};
+
+WorkerPool& GetPool() {
+  static WorkerPool pool(S21Runtime::Threads());
+  return pool;
+}
+
+}  // namespace
+
+void S21Scheduler::Post(std::function<void()> task) {
+  GetPool().Post(std::move(task));
+}
+
+void S21Scheduler::Parallel(int count, int threads, void (*run)(void*, int),
+                            void* context) {
+  Job job;
+  job.run = run;
+  job.context = context;
+  job.count = count;
+  job.max_helpers = std::min(threads, count) - 1;
+  if (job.max_helpers > 0)
+    GetPool().Parallel(job);
+  else
+    for (int i = 0; i < count; i++) run(context, i);
+  if (job.error) std::rethrow_exception(job.error);
+}
@@ -0,0 +1,106 @@
+#ifndef S21_MATRIX_TASKS_H_
+#define S21_MATRIX_TASKS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+// kReproducible, the default, splits parallel reductions by the problem
+// shape alone, so their results are bitwise identical for any thread count
+// and tuning profile. kFast gives each thread one contiguous share instead.
+// Products and factorizations accumulate in a fixed order in both modes.
+enum class S21Determinism { kReproducible, kFast };
+
+class S21Runtime {
+ public:
+  // Number of threads used by the parallel kernels; 0 restores the default
+  // of one thread per hardware core.
+  static int Threads() noexcept;
+  static void SetThreads(int threads);
+  // The mode of the innermost S21DeterminismScope on the calling thread, or
+  // the global mode if there is none.
+  static S21Determinism Determinism() noexcept;
+  static void SetDeterminism(S21Determinism mode) noexcept;
+
+ private:
+  friend class S21DeterminismScope;
+
+  static std::atomic<int> threads_;
+  static std::atomic<S21Determinism> determinism_;
+  static thread_local int scoped_;
+};
+
+// Overrides the determinism mode for the calls made on the constructing
+// thread until it is destroyed. Asynchronous operations run on the
+// scheduler's threads and use the global mode.
+class S21DeterminismScope {
+ public:
+  explicit S21DeterminismScope(S21Determinism mode) noexcept;
+  S21DeterminismScope(const S21DeterminismScope&) = delete;
+  S21DeterminismScope& operator=(const S21DeterminismScope&) = delete;
+  ~S21DeterminismScope();
+
+ private:
+  int previous_;
+};
+
+// A DAG of tasks. Dependencies must refer to tasks added earlier, so the
+// insertion order is always a valid serial schedule.
+class S21TaskGraph {
+ public:
+  int Add(std::function<void()> task, std::initializer_list<int> deps = {});
+  int Size() const noexcept;
+  // Runs every task on up to `threads` threads, the caller included, and
+  // rethrows the first exception thrown by a task.
+  void Run(int threads);
+
+ private:
+  struct Node {
+    std::function<void()> task;
+    std::vector<int> next;
+    int deps = 0;
+  };
+  std::vector<Node> nodes_;
+};
+
+// Process-wide worker pool behind the asynchronous operations and the
+// parallel kernels. Workers start on first use, one per S21Runtime::Threads()
+// at that moment, more join if a later call asks for more threads, and they
+// finish the queued tasks before the program exits. Posted tasks must not
+// throw.
+class S21Scheduler {
+ public:
+  static void Post(std::function<void()> task);
+  // Calls run(context, i) for every i in [0, count) on the calling thread,
+  // joined by up to threads - 1 idle workers, and rethrows the first
+  // exception. The caller never waits for a worker to become free, so
+  // nested calls cannot deadlock, and nothing is allocated per call.
+  static void Parallel(int count, int threads, void (*run)(void*, int),
+                       void* context);
+};
+
+// Runs body(b, e) over [begin, end) split into chunks of `grain` items. The
+// split depends only on the range, never on the thread count.
+template <typename Body>
+void S21ParallelFor(int begin, int end, int grain, Body body) {
+  if (end - begin <= grain) {
+    if (begin < end) body(begin, end);
+    return;
+  }
+  struct Range {
+    int begin, end, grain;
+    Body* body;
+  } range{begin, end, grain, &body};
+  S21Scheduler::Parallel(
+      (end - begin - 1) / grain + 1, S21Runtime::Threads(),
+      [](void* context, int i) {
+        const Range& r = *static_cast<Range*>(context);
+        const int b = r.begin + i * r.grain;
+        (*r.body)(b, b + std::min(r.grain, r.end - b));
+      },
+      &range);
+}
+
+#endif  // S21_MATRIX_TASKS_H_
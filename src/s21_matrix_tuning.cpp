@@ -0,0 +1,110 @@
+#include "s21_matrix_tuning.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+struct Field {
+  const char* key;
+  int S21TuningProfile::*value;
+};
+
+constexpr std::array<Field, 4> kFields = {{
+    {"gemm_block", &S21TuningProfile::gemm_block},
+    {"transpose_block", &S21TuningProfile::transpose_block},
+    {"factor_block", &S21TuningProfile::factor_block},
+    {"parallel_grain", &S21TuningProfile::parallel_grain},
+}};
+
+std::string Trim(const std::string& s) {
+  const size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) return "";
+  return s.substr(begin, s.find_last_not_of(" \t\r") - begin + 1);
+}
+
+// Kernels read the parameters on every call, so each one is a relaxed
+// atomic rather than a locked profile.
+class Storage {
+ public:
+  Storage() {
+    const S21TuningProfile defaults;
+    for (size_t i = 0; i < kFields.size(); i++)
+      values_[i].store(defaults.*kFields[i].value);
+    const char* path = std::getenv("S21_MATRIX_PROFILE");
+    Read(path ? path : "s21_matrix.profile");
+  }
+
+  S21TuningProfile Get() const noexcept {
+    S21TuningProfile profile;
+    for (size_t i = 0; i < kFields.size(); i++)
+      profile.*kFields[i].value = values_[i].load(std::memory_order_relaxed);
+    return profile;
+  }
+
+  void Set(const S21TuningProfile& profile) noexcept {
+    for (size_t i = 0; i < kFields.size(); i++)
+      values_[i].store(profile.*kFields[i].value, std::memory_order_relaxed);
+  }
+
+  bool Read(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+      line = line.substr(0, line.find('#'));
+      const size_t eq = line.find('=');
+      if (eq == std::string::npos) continue;
+      const std::string key = Trim(line.substr(0, eq));
+      std::istringstream value(line.substr(eq + 1));
+      int parsed = 0;
+      std::string rest;
+      if (!(value >> parsed) || value >> rest || parsed < 1) continue;
+      for (size_t i = 0; i < kFields.size(); i++)
+        if (key == kFields[i].key)
+          values_[i].store(parsed, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+ private:
+  std::array<std::atomic<int>, kFields.size()> values_;
+};
+
+Storage& GetStorage() {
+  static Storage storage;
+  return storage;
+}
+
+}  // namespace
+
+bool S21TuningProfile::operator==(
+    const S21TuningProfile& other) const noexcept {
+  for (const Field& field : kFields)
+    if (this->*field.value != other.*field.value) return false;
+  return true;
+}
+
+S21TuningProfile S21Tuning::Get() noexcept { return GetStorage().Get(); }
+
+void S21Tuning::Set(const S21TuningProfile& profile) {
+  for (const Field& field : kFields)
+    if (profile.*field.value < 1) throw std::out_of_range("Out of range");
+  GetStorage().Set(profile);
+}
+
+bool S21Tuning::Load(const std::string& path) {
+  return GetStorage().Read(path);
+}
+
+void S21Tuning::Save(const std::string& path) {
+  std::ofstream out(path);
+  if (!out) throw std::runtime_error("Cannot write " + path);
+  const S21TuningProfile profile = Get();
+  for (const Field& field : kFields)
+    out << field.key << " = " << profile.*field.value << '\n';
+}
@@ -0,0 +1,37 @@
+#ifndef S21_MATRIX_TUNING_H_
+#define S21_MATRIX_TUNING_H_
+
+#include <string>
+
+// Host-dependent kernel parameters. `make tune` measures them and writes a
+// profile; the defaults below are used for anything the profile lacks.
+struct S21TuningProfile {
+  // Edge of the k x j tiles of B reused across the rows of A in Gemm.
+  int gemm_block = 64;
+  // Edge of the tiles copied by layout changes.
+  int transpose_block = 32;
+  // Panel and tile width of the blocked LU and Cholesky factorizations.
+  int factor_block = 64;
+  // Elements per chunk of the parallel row loops. Reproducible reductions
+  // keep this default so that their results do not depend on the profile.
+  int parallel_grain = 1 << 15;
+
+  bool operator==(const S21TuningProfile& other) const noexcept;
+};
+
+class S21Tuning {
+ public:
+  // The active profile. On first use it is read from the file named by the
+  // S21_MATRIX_PROFILE environment variable, or from s21_matrix.profile in
+  // the working directory if that is unset.
+  static S21TuningProfile Get() noexcept;
+  // Throws std::out_of_range if a parameter is below 1.
+  static void Set(const S21TuningProfile& profile);
+  // Reads `key = value` lines on top of the active profile. Unknown keys,
+  // malformed lines and values below 1 are skipped. Returns false if the
+  // file cannot be opened.
+  static bool Load(const std::string& path);
+  static void Save(const std::string& path);
+};
+
+#endif  // S21_MATRIX_TUNING_H_
@@ -1,6 +1,81 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <utility>
+
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_eigen.h"
+#include "s21_matrix_incremental.h"
+#include "s21_matrix_lu.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_qr.h"
+#include "s21_matrix_stats.h"
+#include "s21_matrix_svd.h"
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+// Counts every allocation made through the global operator new, in all of
+// its plain, array and nothrow forms, and frees them all the same way. The
+// replacements stay out of line so that inlined pairs of new and free do
+// not look mismatched to the compiler.
+std::atomic<long> allocations{0};
+
+void* CountedMalloc(size_t size) noexcept {
+  allocations++;
+  return std::malloc(size ? size : 1);
+}
+
+[[gnu::noinline]] void* operator new(size_t size) {
+  if (void* p = CountedMalloc(size)) return p;
+  throw std::bad_alloc();
+}
+[[gnu::noinline]] void* operator new[](size_t size) {
+  if (void* p = CountedMalloc(size)) return p;
+  throw std::bad_alloc();
+}
+[[gnu::noinline]] void* operator new(size_t size,
+                                     const std::nothrow_t&) noexcept {
+  return CountedMalloc(size);
+}
+[[gnu::noinline]] void* operator new[](size_t size,
+                                       const std::nothrow_t&) noexcept {
+  return CountedMalloc(size);
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete[](void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+[[gnu::noinline]] void operator delete[](void* p, size_t) noexcept {
+  std::free(p);
+}
+[[gnu::noinline]] void operator delete(void* p,
+                                       const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+[[gnu::noinline]] void operator delete[](void* p,
+                                         const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+// Deterministic test matrix with entries uniform in [-1, 1). The same
+// shape and seed give the same logical elements in either layout.
+S21Matrix Generic(int rows, int cols, unsigned seed = 0,
+                  S21Layout layout = S21Layout::kRowMajor) {
+  std::seed_seq seq{rows, cols, static_cast<int>(seed)};
+  std::mt19937 gen(seq);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  S21Matrix res(rows, cols, layout);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) res(i, j) = dist(gen);
+  return res;
+}
 
 TEST(Test, DefaultConstructor) {
   S21Matrix matrix;
@@ -731,7 +806,1181 @@ TEST(Test, copy2) {
   EXPECT_DOUBLE_EQ(mat(0, 0), mat2(0, 0));
 }
 
+TEST(Test, FloatMatrix) {
+  S21MatrixF a(2, 2);
+  a(0, 0) = 4;
+  a(0, 1) = 7;
+  a(1, 0) = 2;
+  a(1, 1) = 6;
+  S21MatrixF res(2, 2);
+  res(0, 0) = 0.6f;
+  res(0, 1) = -0.7f;
+  res(1, 0) = -0.2f;
+  res(1, 1) = 0.4f;
+  EXPECT_FLOAT_EQ(a.Determinant(), 10);
+  EXPECT_TRUE(res == a.InverseMatrix());
+  EXPECT_GT(S21MatrixF::eps, 1e-7f);
+}
+
+TEST(Test, LongDoubleMatrix) {
+  S21MatrixLD a(2, 2);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 0) = 3;
+  a(1, 1) = 4;
+  S21MatrixLD b(a);
+  a.MulMatrix(b);
+  EXPECT_EQ(a(0, 0), 7);
+  EXPECT_EQ(a(1, 1), 22);
+}
+
+TEST(Test, ConvertPrecision) {
+  S21Matrix a;
+  S21MatrixF b(a);
+  ASSERT_EQ(b.GetRows(), 3);
+  ASSERT_EQ(b.GetCols(), 3);
+  EXPECT_FLOAT_EQ(b(2, 2), 9);
+}
+
+TEST(Test, InverseMixed1) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 2;
+  a(0, 1) = 5;
+  a(0, 2) = 7;
+  a(1, 0) = 6;
+  a(1, 1) = 3;
+  a(1, 2) = 4;
+  a(2, 0) = 5;
+  a(2, 1) = -2;
+  a(2, 2) = -3;
+  S21Matrix inv = a.InverseMatrixMixed();
+  EXPECT_TRUE(inv == a.InverseMatrix());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) EXPECT_NEAR((a * inv)(i, j), i == j, 1e-12);
+}
+
+TEST(Test, InverseMixed2) {
+  S21Matrix a;
+  EXPECT_THROW(a.InverseMatrixMixed(), std::logic_error);
+  S21Matrix b(2, 3);
+  EXPECT_THROW(b.InverseMatrixMixed(), std::logic_error);
+}
+
+TEST(Test, InverseMixed3) {
+  const int n = 7;
+  S21Matrix hilbert(n, n, S21Matrix::kUninitialized);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) hilbert(i, j) = 1.0 / (i + j + 1);
+  S21Matrix r = S21Matrix::Identity(n);
+  S21Matrix::Gemm(-1, hilbert, false, hilbert.InverseMatrixMixed(), false, 1,
+                  r);
+  EXPECT_LT(r.Norm(S21Norm::kInf), 1e-7);
+}
+
+TEST(Test, Gemm1) {
+  S21Matrix a(3, 2);
+  a(0, 0) = 1;
+  a(0, 1) = 4;
+  a(1, 0) = 2;
+  a(1, 1) = 5;
+  a(2, 0) = 3;
+  a(2, 1) = 6;
+  S21Matrix b(2, 3);
+  b(0, 0) = 1;
+  b(0, 1) = -1;
+  b(0, 2) = 1;
+  b(1, 0) = 2;
+  b(1, 1) = 3;
+  b(1, 2) = 4;
+  S21Matrix c(3, 3);
+  for (int i = 0; i < 3; i++) c(i, i) = 1;
+  S21Matrix res = a * b * 2;
+  for (int i = 0; i < 3; i++) res(i, i) += 3;
+  S21Matrix::Gemm(2, a, false, b, false, 3, c);
+  EXPECT_TRUE(c == res);
+}
+
+TEST(Test, Gemm2) {
+  S21Matrix a(3, 2);
+  S21Matrix b(2, 4);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 2; j++) a(i, j) = i - 2 * j + 0.5;
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 4; j++) b(i, j) = i * j - 1;
+  S21Matrix at = a.Transpose(), bt = b.Transpose();
+  S21Matrix res = a * b;
+  S21Matrix c(3, 4);
+  S21Matrix::Gemm(1, at, true, b, false, 0, c);
+  EXPECT_TRUE(c == res);
+  S21Matrix::Gemm(1, a, false, bt, true, 0, c);
+  EXPECT_TRUE(c == res);
+  S21Matrix::Gemm(1, at, true, bt, true, 0, c);
+  EXPECT_TRUE(c == res);
+}
+
+TEST(Test, Gemm3) {
+  S21Matrix a(2, 2), b(2, 3), c(2, 2);
+  EXPECT_THROW(S21Matrix::Gemm(1, a, false, b, false, 0, c), std::logic_error);
+  EXPECT_THROW(S21Matrix::Gemm(1, a, false, a, false, 0, a), std::logic_error);
+  EXPECT_THROW(S21Matrix::Gemm(1, a, true, b, true, 0, c), std::logic_error);
+}
+
+TEST(Test, Stats1) {
+  S21Stats::Reset();
+  S21Matrix a(2, 3), b(3, 4);
+  a.MulMatrix(b);
+  S21StatsSnapshot snapshot = S21Stats::Snapshot();
+  const uint64_t calls = S21Stats::Enabled() ? 1 : 0;
+  EXPECT_EQ(snapshot[S21Op::kMulMatrix].calls, calls);
+  EXPECT_EQ(snapshot[S21Op::kGemm].flops, calls * 2 * 2 * 3 * 4);
+  EXPECT_EQ(snapshot[S21Op::kConstruct].calls, calls * 3);
+  EXPECT_EQ(snapshot[S21Op::kConstruct].allocations, calls * 3);
+  EXPECT_EQ(snapshot[S21Op::kDeterminant].calls, 0u);
+}
+
+TEST(Test, Stats2) {
+  S21Stats::Reset();
+  std::thread worker([] {
+    S21Matrix a;
+    a.Determinant();
+  });
+  worker.join();
+  S21StatsSnapshot snapshot = S21Stats::Snapshot();
+  std::string json = snapshot.ToJson();
+  EXPECT_NE(json.find("\"Determinant\":{\"calls\":"), std::string::npos);
+  EXPECT_EQ(snapshot[S21Op::kDeterminant].calls,
+            S21Stats::Enabled() ? 1u : 0u);
+  S21Stats::Reset();
+  EXPECT_EQ(S21Stats::Snapshot()[S21Op::kDeterminant].calls, 0u);
+}
+
+TEST(Test, BlockedLU1) {
+  S21Matrix a = Generic(150, 150);
+  S21Runtime::SetThreads(1);
+  double serial = a.Determinant();
+  S21Runtime::SetThreads(4);
+  double parallel = a.Determinant();
+  S21Matrix inv = a.InverseMatrix();
+  S21Runtime::SetThreads(0);
+  EXPECT_NEAR(parallel / serial, 1, 1e-12);
+  S21Matrix id = a * inv;
+  for (int i = 0; i < 150; i++)
+    for (int j = 0; j < 150; j++) ASSERT_NEAR(id(i, j), i == j, 1e-12);
+}
+
+TEST(Test, BlockedLU2) {
+  S21Matrix a = Generic(130, 130);
+  // A rounded combination of rows would leave the matrix barely regular;
+  // an exact multiple keeps it singular in floating point too.
+  for (int j = 0; j < 130; j++) a(129, j) = -2 * a(3, j);
+  S21Runtime::SetThreads(3);
+  EXPECT_EQ(a.Determinant(), 0);
+  EXPECT_THROW(a.InverseMatrix(), std::logic_error);
+  S21Runtime::SetThreads(0);
+}
+
+TEST(Test, TinyPivots) {
+  S21Matrix a = S21Matrix::Identity(2);
+  a(1, 1) = 1e-20;
+  EXPECT_DOUBLE_EQ(a.Determinant(), 1e-20);
+  EXPECT_DOUBLE_EQ(a.InverseMatrix()(1, 1), 1e20);
+  S21Matrix b = S21Matrix::Identity(3);
+  b(0, 0) = 1e8;
+  b(2, 2) = 1e-9;
+  EXPECT_DOUBLE_EQ(b.Determinant(), 0.1);
+  EXPECT_DOUBLE_EQ(b.InverseMatrix()(2, 2), 1e9);
+  a(0, 1) = 1;
+  EXPECT_DOUBLE_EQ(a.InverseMatrix()(0, 1), -1e20);
+  // The tolerance applies only where it is asked for.
+  EXPECT_TRUE(a.IsSingular());
+  // A pivot left over from cancellation is still zero.
+  EXPECT_EQ(S21Matrix().Determinant(), 0);
+}
+
+TEST(Test, TaskGraph) {
+  std::vector<int> order;
+  std::mutex mutex;
+  S21TaskGraph graph;
+  int first = graph.Add([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(0);
+  });
+  int second = graph.Add([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(1);
+  }, {first});
+  graph.Add([&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(2);
+  }, {second});
+  graph.Run(3);
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+  EXPECT_THROW(graph.Add([] {}, {5}), std::logic_error);
+  S21TaskGraph failing;
+  failing.Add([] { throw std::runtime_error("task"); });
+  failing.Add([] {});
+  EXPECT_THROW(failing.Run(2), std::runtime_error);
+  EXPECT_THROW(S21Runtime::SetThreads(-1), std::out_of_range);
+}
+
+TEST(Test, TaskGraph2) {
+  S21Runtime::SetThreads(4);
+  std::atomic<long> sum{0};
+  S21TaskGraph graph;
+  int last = -1;
+  for (int t = 0; t < 8; t++)
+    last = graph.Add(
+        [&] {
+          S21ParallelFor(0, 1000, 10, [&](int b, int e) {
+            for (int i = b; i < e; i++) sum += i;
+          });
+        },
+        {last});
+  graph.Run(4);
+  EXPECT_EQ(sum, 8 * 499500);
+  EXPECT_THROW(S21ParallelFor(0, 100, 1,
+                              [](int b, int) {
+                                if (b == 50) throw std::runtime_error("body");
+                              }),
+               std::runtime_error);
+  S21Matrix a = Generic(100, 100);
+  S21Matrix::future_type inverse = S21Matrix::InverseMatrixAsync(a);
+  for (int i = 0; i < 20; i++) S21ParallelFor(0, 4, 1, [](int, int) {});
+  const auto tol = S21Tolerance<double>::Absolute(1e-6);
+  EXPECT_TRUE((inverse.Get() * a).EqMatrix(S21Matrix::Identity(100), tol));
+  S21Runtime::SetThreads(0);
+}
+
+TEST(Test, Cholesky1) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 4;
+  a(0, 1) = 12;
+  a(0, 2) = -16;
+  a(1, 0) = 12;
+  a(1, 1) = 37;
+  a(1, 2) = -43;
+  a(2, 0) = -16;
+  a(2, 1) = -43;
+  a(2, 2) = 98;
+  S21Matrix l(3, 3);
+  l(0, 0) = 2;
+  l(1, 0) = 6;
+  l(1, 1) = 1;
+  l(2, 0) = -8;
+  l(2, 1) = 5;
+  l(2, 2) = 3;
+  S21Cholesky<double> chol(a);
+  EXPECT_TRUE(chol.L() == l);
+  EXPECT_DOUBLE_EQ(chol.Determinant(), 36);
+  EXPECT_DOUBLE_EQ(chol.LogDeterminant(), std::log(36.0));
+  EXPECT_TRUE(chol.Inverse() == a.InverseMatrix());
+}
+
+TEST(Test, Cholesky2) {
+  S21Matrix b = Generic(140, 140);
+  S21Matrix a(140, 140);
+  S21Matrix::Gemm(1, b, false, b, true, 0, a);
+  S21Matrix x(140, 2);
+  for (int i = 0; i < 140; i++) x(i, 0) = x(i, 1) = i % 7 - 3;
+  S21Matrix rhs = a * x;
+  S21Runtime::SetThreads(4);
+  S21Cholesky<double> chol(a);
+  S21Runtime::SetThreads(0);
+  EXPECT_NEAR(chol.LogDeterminant(), S21QR<double>(a).LogDeterminant(), 1e-8);
+  EXPECT_TRUE(chol.Solve(rhs) == x);
+}
+
+TEST(Test, Cholesky3) {
+  S21Matrix a;
+  EXPECT_THROW(S21Cholesky<double>{a}, std::logic_error);
+  S21Matrix b(2, 3);
+  EXPECT_THROW(S21Cholesky<double>{b}, std::logic_error);
+}
+
+TEST(Test, QR1) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 2;
+  a(0, 1) = 5;
+  a(0, 2) = 7;
+  a(1, 0) = 6;
+  a(1, 1) = 3;
+  a(1, 2) = 4;
+  a(2, 0) = 5;
+  a(2, 1) = -2;
+  a(2, 2) = -3;
+  S21QR<double> qr(a);
+  EXPECT_NEAR(qr.Determinant(), a.Determinant(), 1e-12);
+  EXPECT_TRUE(qr.Q() * qr.R() == a);
+  S21Matrix id(3, 3);
+  for (int i = 0; i < 3; i++) id(i, i) = 1;
+  EXPECT_TRUE(qr.Solve(id) == a.InverseMatrix());
+}
+
+TEST(Test, QR2) {
+  S21Matrix a(4, 2), b(4, 1);
+  for (int i = 0; i < 4; i++) {
+    a(i, 0) = 1;
+    a(i, 1) = i;
+    b(i, 0) = 3 + 2 * i + (i % 2 ? 0.5 : -0.5);
+  }
+  S21Matrix x = S21QR<double>(a).Solve(b);
+  EXPECT_NEAR(x(0, 0), 2.7, 1e-12);
+  EXPECT_NEAR(x(1, 0), 2.2, 1e-12);
+  EXPECT_THROW(S21QR<double>(a).Determinant(), std::logic_error);
+  EXPECT_THROW(S21QR<double>(a.Transpose()), std::logic_error);
+  S21Matrix singular;
+  S21QR<double> qr(singular);
+  EXPECT_TRUE(qr.IsRankDeficient());
+  EXPECT_NEAR(qr.Determinant(), 0, 1e-12);
+  EXPECT_THROW(qr.Solve(b), std::logic_error);
+  S21Matrix tiny = S21Matrix::Identity(2);
+  tiny(1, 1) = 1e-20;
+  EXPECT_DOUBLE_EQ(S21QR<double>(tiny).Determinant(), 1e-20);
+}
+
+TEST(Test, CopyOnWrite1) {
+  S21Matrix a;
+  a.SetCopyOnWrite(true);
+  S21Matrix b(a);
+  const S21Matrix& cb = b;
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_TRUE(b.IsCopyOnWrite());
+  EXPECT_EQ(&cb(1, 1), &static_cast<const S21Matrix&>(a)(1, 1));
+  b(1, 1) = 50;
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_FALSE(b.IsShared());
+  EXPECT_EQ(a(1, 1), 5);
+  EXPECT_EQ(b(1, 1), 50);
+}
+
+TEST(Test, CopyOnWrite2) {
+  S21Matrix a;
+  a.SetCopyOnWrite(true);
+  S21Matrix b(2, 2), c(3, 3);
+  b = a;
+  c = a;
+  EXPECT_TRUE(b.IsShared());
+  c.MulMatrix(a);
+  EXPECT_TRUE(c.IsCopyOnWrite());
+  EXPECT_FALSE(c.IsShared());
+  EXPECT_EQ(c(0, 0), 30);
+  b.SumMatrix(a);
+  EXPECT_EQ(b(2, 2), 18);
+  EXPECT_EQ(a(2, 2), 9);
+  S21Matrix d(a);
+  d.SetCopyOnWrite(false);
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_FALSE(d.IsCopyOnWrite());
+  S21Matrix e(d);
+  EXPECT_FALSE(e.IsShared());
+}
+
+TEST(Test, CopyOnWrite4) {
+  S21Matrix a = Generic(4, 4);
+  a.SetCopyOnWrite(true);
+  double& r = a(0, 0);
+  S21Matrix b(a), c;
+  c = a;
+  r = 42;
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_DOUBLE_EQ(b(0, 0), Generic(4, 4)(0, 0));
+  EXPECT_DOUBLE_EQ(c(0, 0), Generic(4, 4)(0, 0));
+  EXPECT_TRUE(b.IsCopyOnWrite());
+  a.SetCopyOnWrite(true);
+  S21Matrix d(a);
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_DOUBLE_EQ(std::as_const(d)(0, 0), 42);
+  S21Matrix m(2, 2);
+  m.SetCopyOnWrite(true);
+  m(0, 0) = 1;
+  m.MulNumber(2);
+  S21Matrix e(m);
+  EXPECT_TRUE(m.IsShared());
+  EXPECT_TRUE(e.IsShared());
+  m(1, 1) = 3;
+  m += m;
+  c = m;
+  EXPECT_TRUE(c.IsShared());
+}
+
+TEST(Test, CopyOnWrite3) {
+  S21Matrix a = Generic(64, 64);
+  a.SetCopyOnWrite(true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+    threads.emplace_back([&a, t] {
+      for (int i = 0; i < 200; i++) {
+        S21Matrix copy(a);
+        if (i % 2) copy(t, t) += 1;
+      }
+    });
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_TRUE(a == Generic(64, 64));
+}
+
+TEST(Test, AppendRow1) {
+  S21Matrix m(1, 3), row(1, 3);
+  int reallocations = 0;
+  for (int i = 1; i < 1000; i++) {
+    const int capacity = m.GetRowsCapacity();
+    for (int j = 0; j < 3; j++) row(0, j) = i * 3 + j;
+    m.AppendRow(row);
+    if (m.GetRowsCapacity() != capacity) reallocations++;
+  }
+  EXPECT_EQ(m.GetRows(), 1000);
+  EXPECT_EQ(reallocations, 10);
+  EXPECT_EQ(m(0, 2), 0);
+  EXPECT_EQ(m(999, 2), 2999);
+  S21Matrix wrong(1, 2);
+  EXPECT_THROW(m.AppendRow(wrong), std::logic_error);
+  EXPECT_THROW(m.AppendRow(m), std::logic_error);
+  row.AppendRow(row);
+  EXPECT_EQ(row(1, 2), row(0, 2));
+}
+
+TEST(Test, Capacity1) {
+  S21Matrix m;
+  m.Reserve(10, 8);
+  EXPECT_EQ(m.GetRowsCapacity(), 10);
+  EXPECT_EQ(m.GetColsCapacity(), 8);
+  EXPECT_EQ(m(2, 2), 9);
+  m.SetRows(2);
+  m.SetCols(1);
+  EXPECT_EQ(m.GetRowsCapacity(), 10);
+  EXPECT_EQ(m.GetColsCapacity(), 8);
+  m.SetRows(4);
+  m.SetCols(3);
+  EXPECT_EQ(m(1, 0), 4);
+  EXPECT_EQ(m(0, 1), 0);
+  EXPECT_EQ(m(2, 0), 0);
+  EXPECT_EQ(m(3, 2), 0);
+  m.SetCols(9);
+  EXPECT_EQ(m.GetColsCapacity(), 16);
+  EXPECT_EQ(m(1, 0), 4);
+  EXPECT_THROW(m.Reserve(0, 1), std::out_of_range);
+}
+
+TEST(Test, Capacity2) {
+  S21Matrix a;
+  a.SetCopyOnWrite(true);
+  S21Matrix b(a);
+  b.SetRows(1);
+  b.SetRows(3);
+  EXPECT_EQ(b(2, 2), 0);
+  EXPECT_EQ(std::as_const(a)(2, 2), 9);
+  S21Matrix c(8, 8);
+  c = a;
+  EXPECT_EQ(c.GetRowsCapacity(), 3);
+  S21Matrix d(8, 8);
+  a.SetCopyOnWrite(false);
+  d = a;
+  EXPECT_EQ(d.GetRowsCapacity(), 8);
+  EXPECT_TRUE(d == a);
+}
+
+TEST(Test, Tolerance1) {
+  S21Matrix a(2, 2), b(2, 2);
+  a(0, 0) = 1e6;
+  a(0, 1) = 1;
+  a(1, 0) = -3;
+  a(1, 1) = 0;
+  b = a;
+  b(0, 0) = 1e6 + 1e-3;
+  EXPECT_FALSE(a.EqMatrix(b));
+  EXPECT_TRUE(a.EqMatrix(b, S21Tolerance<double>::Absolute(1e-2)));
+  EXPECT_TRUE(a.EqMatrix(b, S21Tolerance<double>::Relative(1e-8)));
+  EXPECT_FALSE(a.EqMatrix(b, S21Tolerance<double>::Relative(1e-10)));
+  EXPECT_TRUE(a.EqMatrix(b, S21Tolerance<double>::Norm(1e-8)));
+  EXPECT_FALSE(a.EqMatrix(b, S21Tolerance<double>::Ulp(4)));
+  b(0, 0) = std::nextafter(1e6, 2e6);
+  b(0, 0) = std::nextafter(b(0, 0), 2e6);
+  EXPECT_TRUE(a.EqMatrix(b, S21Tolerance<double>::Ulp(2)));
+  EXPECT_FALSE(a.EqMatrix(b, S21Tolerance<double>::Ulp(1)));
+  S21Matrix c(2, 3);
+  EXPECT_FALSE(a.EqMatrix(c, S21Tolerance<double>::Absolute(1)));
+}
+
+TEST(Test, Tolerance2) {
+  S21Matrix a = Generic(40, 40), b = Generic(40, 40);
+  b(17, 33) += 0.5;
+  b(5, 1) -= 0.25;
+  S21Comparison<double> cmp =
+      a.Compare(b, S21Tolerance<double>::Absolute(0.3));
+  EXPECT_FALSE(cmp.equal);
+  EXPECT_EQ(cmp.row, 17);
+  EXPECT_EQ(cmp.col, 33);
+  EXPECT_NEAR(cmp.max_error, 0.5, 1e-12);
+  cmp = a.Compare(a, S21Tolerance<double>::Ulp(0));
+  EXPECT_TRUE(cmp.equal);
+  EXPECT_EQ(cmp.row, -1);
+  b(0, 0) = NAN;
+  EXPECT_FALSE(a.EqMatrix(b, S21Tolerance<double>::Absolute(1e9)));
+  cmp = a.Compare(b, S21Tolerance<double>::Absolute(1e9));
+  EXPECT_FALSE(cmp.equal);
+  EXPECT_EQ(cmp.row, 0);
+  b(0, 0) = a(0, 0);
+  cmp = a.Compare(b, S21Tolerance<double>::Norm(1e-1));
+  EXPECT_TRUE(cmp.equal);
+  EXPECT_EQ(cmp.row, 17);
+  EXPECT_GT(cmp.max_error, 0);
+}
+
+TEST(Test, Reductions1) {
+  S21Matrix a(2, 3);
+  double v[] = {1, -2, 3, -4, 5, -6};
+  for (int i = 0; i < 6; i++) a(i / 3, i % 3) = v[i];
+  EXPECT_DOUBLE_EQ(a.Norm(S21Norm::kOne), 9);
+  EXPECT_DOUBLE_EQ(a.Norm(S21Norm::kInf), 15);
+  EXPECT_DOUBLE_EQ(a.Norm(S21Norm::kMax), 6);
+  EXPECT_DOUBLE_EQ(a.Norm(), std::sqrt(91.0));
+  EXPECT_DOUBLE_EQ(a.Min(), -6);
+  EXPECT_DOUBLE_EQ(a.Max(), 5);
+  EXPECT_DOUBLE_EQ(a.Dot(a), 91);
+  S21Matrix rows = a.RowSums(), cols = a.ColSums();
+  EXPECT_EQ(rows.GetRows(), 2);
+  EXPECT_EQ(cols.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(rows(1, 0), -5);
+  EXPECT_DOUBLE_EQ(cols(0, 2), -3);
+  EXPECT_THROW(a.Trace(), std::logic_error);
+  EXPECT_DOUBLE_EQ(Generic(3, 3).Trace(),
+                   Generic(3, 3)(0, 0) + Generic(3, 3)(1, 1) +
+                       Generic(3, 3)(2, 2));
+  a.Hadamard(a);
+  a.Apply([](double x) { return std::sqrt(x); });
+  EXPECT_DOUBLE_EQ(a(1, 2), 6);
+  EXPECT_THROW(a.Hadamard(rows), std::logic_error);
+}
+
+TEST(Test, Reductions2) {
+  S21Matrix a(700, 300);
+  a.Apply([](double) { return 0.1; });
+  a(3, 4) = 1e16;
+  a(600, 4) = -1e16;
+  S21Runtime::SetThreads(1);
+  double sum1 = a.ColSums()(0, 4), dot1 = a.Dot(a);
+  S21Runtime::SetThreads(4);
+  EXPECT_EQ(a.ColSums()(0, 4), sum1);
+  EXPECT_EQ(a.Dot(a), dot1);
+  S21Runtime::SetThreads(0);
+  EXPECT_NEAR(sum1, 69.8, 1e-9);
+  EXPECT_NEAR(a.RowSums()(10, 0), 30, 1e-12);
+}
+
+TEST(Test, SymmetricEigen1) {
+  S21Matrix a(2, 2);
+  a(0, 0) = a(1, 1) = 2;
+  a(1, 0) = 1;
+  S21SymmetricEigen<double> eigen(a);
+  EXPECT_NEAR(eigen.Values()(0, 0), 1, 1e-12);
+  EXPECT_NEAR(eigen.Values()(1, 0), 3, 1e-12);
+  EXPECT_NEAR(std::abs(eigen.Vectors()(0, 1)), std::sqrt(0.5), 1e-12);
+  EXPECT_THROW(S21SymmetricEigen<double>(a, false).Vectors(),
+               std::logic_error);
+}
+
+TEST(Test, SymmetricEigen2) {
+  S21Matrix b = Generic(130, 130), a(130, 130);
+  S21Matrix::Gemm(1, b, false, b, true, 0, a);
+  S21Runtime::SetThreads(4);
+  S21SymmetricEigen<double> eigen(a);
+  S21Runtime::SetThreads(0);
+  S21Matrix v = eigen.Vectors(), d = eigen.Values(), vd = v;
+  for (int i = 0; i < 130; i++)
+    for (int j = 0; j < 130; j++) vd(i, j) *= d(j, 0);
+  S21Matrix av = a * v, vtv(130, 130);
+  S21Matrix::Gemm(1, v, true, v, false, 0, vtv);
+  EXPECT_TRUE(av.EqMatrix(vd, S21Tolerance<double>::Norm(1e-12)));
+  EXPECT_TRUE(
+      vtv.EqMatrix(S21Matrix(eigen.Vectors()).Transpose() * v,
+                   S21Tolerance<double>::Absolute(1e-12)));
+  for (int i = 0; i < 130; i++) EXPECT_NEAR(vtv(i, i), 1, 1e-12);
+  S21Matrix top = S21SymmetricEigen<double>::Largest(a, 3);
+  EXPECT_NEAR(top(0, 0), d(129, 0), 1e-9 * d(129, 0));
+  EXPECT_NEAR(top(2, 0), d(127, 0), 1e-9 * d(129, 0));
+}
+
+TEST(Test, SymmetricLargest) {
+  S21Matrix a(4, 4);
+  a(0, 0) = 3;
+  a(1, 1) = -1;
+  a(2, 2) = 3;
+  S21Matrix top = S21SymmetricEigen<double>::Largest(a, 4);
+  const double expected[] = {3, 3, 0, -1};
+  for (int i = 0; i < 4; i++) EXPECT_NEAR(top(i, 0), expected[i], 1e-14);
+  S21Matrix b = Generic(60, 60), c(60, 60);
+  S21Matrix::Gemm(1, b, false, b, true, -1, c);
+  S21Matrix d = S21SymmetricEigen<double>(c, false).Values();
+  top = S21SymmetricEigen<double>::Largest(c, 10);
+  for (int i = 0; i < 10; i++)
+    EXPECT_NEAR(top(i, 0), d(59 - i, 0), 1e-12 * d(59, 0));
+  S21Matrix one(1, 1, 7);
+  EXPECT_DOUBLE_EQ(S21SymmetricEigen<double>::Largest(one, 1)(0, 0), 7);
+  EXPECT_THROW(S21SymmetricEigen<double>::Largest(a, 0), std::out_of_range);
+}
+
+TEST(Test, Eigen1) {
+  S21Matrix a(3, 3);
+  a(0, 1) = -1;
+  a(1, 0) = 1;
+  a(2, 2) = 2;
+  S21Eigen<double> eigen(a);
+  S21Matrix re = eigen.Real(), im = eigen.Imag();
+  double re_sum = 0, im_abs = 0;
+  for (int i = 0; i < 3; i++) {
+    re_sum += re(i, 0);
+    im_abs += std::abs(im(i, 0));
+  }
+  EXPECT_NEAR(re_sum, 2, 1e-12);
+  EXPECT_NEAR(im_abs, 2, 1e-12);
+  EXPECT_THROW(S21Eigen<double>(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(Test, Eigen2) {
+  S21Matrix a = Generic(90, 90);
+  S21Eigen<double> eigen(a);
+  S21Matrix z = eigen.Z(), s = eigen.Schur(), zs = z * s, zszt(90, 90);
+  S21Matrix::Gemm(1, zs, false, z, true, 0, zszt);
+  EXPECT_TRUE(zszt.EqMatrix(a, S21Tolerance<double>::Norm(1e-12)));
+  for (int i = 2; i < 90; i++) EXPECT_EQ(s(i, i - 2), 0);
+  for (int i = 1; i < 90; i++)
+    EXPECT_TRUE(s(i, i - 1) == 0 || eigen.Imag()(i, 0) != 0);
+  double re_sum = eigen.Real().ColSums()(0, 0);
+  EXPECT_NEAR(re_sum, a.Trace(), 1e-9);
+}
+
+TEST(Test, SVD1) {
+  S21Matrix a(7, 4);
+  for (int i = 0; i < 7; i++)
+    for (int j = 0; j < 4; j++) a(i, j) = std::sin(i * 4 + j + 1.0);
+  for (S21Matrix m : {a, S21Matrix(a).Transpose()}) {
+    S21SVD<double> svd(m);
+    S21Matrix u = svd.U(), s = svd.Values(), v = svd.V(), us = u;
+    for (int i = 0; i < us.GetRows(); i++)
+      for (int j = 0; j < 4; j++) us(i, j) *= s(j, 0);
+    S21Matrix usvt(m.GetRows(), m.GetCols());
+    S21Matrix::Gemm(1, us, false, v, true, 0, usvt);
+    EXPECT_TRUE(usvt.EqMatrix(m, S21Tolerance<double>::Norm(1e-13)));
+    for (int j = 1; j < 4; j++) EXPECT_GE(s(j - 1, 0), s(j, 0));
+    S21Matrix top = S21SVD<double>::Largest(m, 2);
+    EXPECT_NEAR(top(0, 0), s(0, 0), 1e-10);
+    EXPECT_NEAR(top(1, 0), s(1, 0), 1e-10);
+  }
+  EXPECT_THROW(S21SVD<double>::Largest(a, 5), std::out_of_range);
+}
+
+TEST(Test, SVD2) {
+  S21Matrix a(120, 80);
+  for (int i = 0; i < 120; i++)
+    for (int j = 0; j < 80; j++) a(i, j) = (i % 5 + 1) * (j % 7 - 3);
+  S21Runtime::SetThreads(4);
+  S21SVD<double> svd(a);
+  S21Runtime::SetThreads(0);
+  S21Matrix s = svd.Values();
+  EXPECT_GT(s(0, 0), 1);
+  EXPECT_LT(s(1, 0), 1e-10 * s(0, 0));
+  S21SVD<float> single(S21MatrixF(a), false);
+  EXPECT_NEAR(single.Values()(0, 0), s(0, 0), 1e-4 * s(0, 0));
+}
+
+TEST(Test, Power1) {
+  S21Matrix a = Generic(6, 6) * 0.1, expected(6, 6);
+  for (int i = 0; i < 6; i++) expected(i, i) = 1;
+  EXPECT_TRUE(a.Power(0) == expected);
+  for (int k = 1; k <= 13; k++) {
+    expected *= a;
+    EXPECT_TRUE(a.Power(k).EqMatrix(expected,
+                                    S21Tolerance<double>::Relative(1e-12)));
+  }
+  S21Matrix inv = a.Power(-13) * a.Power(13);
+  for (int i = 0; i < 6; i++) EXPECT_NEAR(inv(i, i), 1, 1e-9);
+  EXPECT_THROW(S21Matrix(2, 3).Power(2), std::logic_error);
+  EXPECT_THROW(S21Matrix(3, 3).Power(-1), std::logic_error);
+}
+
+TEST(Test, Power2) {
+  S21Matrix a(3, 3);
+  double p[] = {0.5, 0.3, 0.2, 0.1, 0.8, 0.1, 0.25, 0.25, 0.5};
+  for (int i = 0; i < 9; i++) a(i / 3, i % 3) = p[i];
+  S21Matrix stationary = a.Power(1000);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(stationary.RowSums()(i, 0), 1, 1e-12);
+    for (int j = 0; j < 3; j++)
+      EXPECT_NEAR(stationary(i, j), stationary(0, j), 1e-12);
+  }
+}
+
+TEST(Test, Exp1) {
+  S21Matrix a(2, 2);
+  a(0, 1) = 1;
+  S21Matrix e = a.Exp();
+  EXPECT_DOUBLE_EQ(e(0, 0), 1);
+  EXPECT_DOUBLE_EQ(e(0, 1), 1);
+  EXPECT_DOUBLE_EQ(e(1, 0), 0);
+  a(0, 1) = -2;
+  a(1, 0) = 2;
+  e = a.Exp();
+  EXPECT_NEAR(e(0, 0), std::cos(2.0), 1e-14);
+  EXPECT_NEAR(e(1, 0), std::sin(2.0), 1e-14);
+  EXPECT_DOUBLE_EQ(S21Matrix(1, 1).Exp()(0, 0), 1);
+  EXPECT_THROW(S21Matrix(2, 3).Exp(), std::logic_error);
+}
+
+TEST(Test, Exp2) {
+  S21Matrix a = Generic(20, 20) * 0.5, minus = a * -1.0;
+  S21Matrix id = a.Exp() * minus.Exp();
+  for (int i = 0; i < 20; i++)
+    for (int j = 0; j < 20; j++) EXPECT_NEAR(id(i, j), i == j, 1e-8);
+  S21Matrix d(3, 3);
+  d(0, 0) = 20;
+  d(1, 1) = -3;
+  d(2, 2) = 0.01;
+  S21Matrix e = d.Exp();
+  EXPECT_NEAR(e(0, 0), std::exp(20.0), 1e-13 * std::exp(20.0));
+  EXPECT_NEAR(e(1, 1), std::exp(-3.0), 1e-15);
+  EXPECT_NEAR(e(2, 2), std::exp(0.01), 1e-15);
+  EXPECT_NEAR(S21MatrixF(d).Exp()(1, 1), std::exp(-3.0), 1e-6);
+}
+
+TEST(Test, Async1) {
+  S21Matrix a = Generic(40, 40), b = Generic(40, 40) * 0.5;
+  S21Matrix::future_type ab = S21Matrix::MulMatrixAsync(a, b);
+  S21Matrix::future_type inv = S21Matrix::InverseMatrixAsync(ab);
+  S21Future<double> det = S21Matrix::DeterminantAsync(inv);
+  S21Matrix expected = (a * b).InverseMatrix();
+  EXPECT_TRUE(inv.Get().EqMatrix(expected));
+  EXPECT_NEAR(det.Get(), expected.Determinant(),
+              1e-12 * std::abs(expected.Determinant()));
+  EXPECT_TRUE(det.IsReady());
+  S21Matrix::future_type sum = S21Matrix::SumMatrixAsync(
+      S21Matrix::TransposeAsync(ab), S21Matrix::MulNumberAsync(ab, -1));
+  S21Matrix antisym = S21Matrix::SubMatrixAsync(sum, S21Matrix(40, 40)).Get();
+  for (int i = 0; i < 40; i++)
+    for (int j = 0; j < 40; j++)
+      EXPECT_DOUBLE_EQ(antisym(i, j), -antisym(j, i));
+}
+
+TEST(Test, Async2) {
+  S21Matrix singular(3, 3);
+  S21Matrix::future_type inv = S21Matrix::InverseMatrixAsync(singular);
+  S21Future<double> det = S21Matrix::DeterminantAsync(inv);
+  EXPECT_THROW(inv.Get(), std::logic_error);
+  EXPECT_THROW(det.Get(), std::logic_error);
+  S21Matrix::future_type bad =
+      S21Matrix::MulMatrixAsync(S21Matrix(2, 3), S21Matrix(2, 3));
+  EXPECT_THROW(bad.Get(), std::logic_error);
+  EXPECT_THROW(S21Matrix::TransposeAsync(S21Matrix::future_type()),
+               std::logic_error);
+}
+
+TEST(Test, Async3) {
+  std::mutex mutex;
+  std::vector<int> order;
+  auto step = [&](int id) {
+    return [&, id](const S21Matrix& m) {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(id);
+      return m;
+    };
+  };
+  S21Matrix::future_type root =
+      S21Matrix::future_type(Generic(8, 8)).Then(step(0));
+  S21Matrix::future_type left = root.Then(step(1)), right = root.Then(step(2));
+  S21Future<double> joined = S21Async::When(
+      [&](const S21Matrix& x, const S21Matrix& y) {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(3);
+        return x.EqMatrix(y) ? x(0, 0) : 0.0;
+      },
+      left, right);
+  EXPECT_DOUBLE_EQ(joined.Get(), Generic(8, 8)(0, 0));
+  ASSERT_EQ(order.size(), 4u);
+  EXPECT_EQ(order.front(), 0);
+  EXPECT_EQ(order.back(), 3);
+}
+
+TEST(Test, Layout1) {
+  S21Matrix a = Generic(50, 37), b = Generic(37, 45);
+  S21Matrix ca = Generic(50, 37, 0, S21Layout::kColMajor);
+  S21Matrix cb = Generic(37, 45, 0, S21Layout::kColMajor);
+  EXPECT_EQ(ca.GetLayout(), S21Layout::kColMajor);
+  EXPECT_EQ(ca.GetRows(), 50);
+  EXPECT_EQ(ca.GetCols(), 37);
+  EXPECT_DOUBLE_EQ(ca(3, 7), a(3, 7));
+  EXPECT_TRUE(ca == a);
+  EXPECT_TRUE(a.EqMatrix(ca));
+  S21Matrix ab = a * b;
+  for (S21Matrix* x : {&a, &ca})
+    for (S21Matrix* y : {&b, &cb}) {
+      EXPECT_TRUE((*x * *y).EqMatrix(ab));
+      S21Matrix z(*x);
+      z.MulMatrix(*y);
+      EXPECT_EQ(z.GetLayout(), x->GetLayout());
+      EXPECT_TRUE(z.EqMatrix(ab));
+    }
+  S21Matrix c(50, 45, S21Layout::kColMajor);
+  S21Matrix::Gemm(1, ca, false, cb, false, 0, c);
+  EXPECT_TRUE(c.EqMatrix(ab));
+  S21Matrix ct(45, 50, S21Layout::kColMajor);
+  S21Matrix::Gemm(1, cb, true, a, true, 0, ct);
+  EXPECT_TRUE(ct.Transpose().EqMatrix(ab));
+  S21Matrix sum = ca + a;
+  sum -= ca;
+  EXPECT_TRUE(sum.EqMatrix(a));
+  EXPECT_DOUBLE_EQ(ca.Dot(a), a.Dot(a));
+  EXPECT_THROW(ca(37, 49), std::out_of_range);
+}
+
+TEST(Test, Layout2) {
+  S21Matrix a = Generic(6, 4);
+  a.SetCopyOnWrite(true);
+  S21Matrix t = a.Transpose();
+  EXPECT_TRUE(a.IsShared());
+  EXPECT_EQ(t.GetRows(), 4);
+  EXPECT_EQ(t.GetLayout(), S21Layout::kColMajor);
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 4; j++) EXPECT_EQ(t(j, i), a(i, j));
+  EXPECT_TRUE(t.Transpose() == a);
+  t.SetLayout(S21Layout::kRowMajor);
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_DOUBLE_EQ(t(3, 5), a(5, 3));
+  EXPECT_DOUBLE_EQ(t.Norm(S21Norm::kOne), a.Norm(S21Norm::kInf));
+  S21Matrix ct = a.Transpose();
+  EXPECT_DOUBLE_EQ(ct.Norm(S21Norm::kOne), t.Norm(S21Norm::kOne));
+  EXPECT_TRUE(ct.RowSums().EqMatrix(t.RowSums()));
+  EXPECT_TRUE(ct.ColSums().EqMatrix(t.ColSums()));
+  t(2, 1) += 1;
+  S21Comparison<double> cmp =
+      ct.Compare(t, S21Tolerance<double>::Absolute(0.5));
+  EXPECT_EQ(cmp.row, 2);
+  EXPECT_EQ(cmp.col, 1);
+  ct.SetRows(5);
+  ct.AppendRow(S21Matrix(1, 6));
+  EXPECT_EQ(ct.GetRows(), 6);
+  EXPECT_GE(ct.GetRowsCapacity(), 6);
+  EXPECT_DOUBLE_EQ(ct(3, 5), a(5, 3));
+  EXPECT_DOUBLE_EQ(ct(5, 5), 0);
+}
+
+TEST(Test, Layout3) {
+  S21Matrix a = Generic(70, 70);
+  S21Matrix ca = Generic(70, 70, 0, S21Layout::kColMajor);
+  EXPECT_NEAR(ca.Determinant(), a.Determinant(),
+              1e-12 * std::abs(a.Determinant()));
+  S21Matrix inv = ca.InverseMatrix();
+  EXPECT_EQ(inv.GetLayout(), S21Layout::kColMajor);
+  EXPECT_TRUE(inv.EqMatrix(a.InverseMatrix()));
+  EXPECT_TRUE(ca.Power(3).EqMatrix(a * a * a,
+                                   S21Tolerance<double>::Relative(1e-12)));
+  S21Matrix b = Generic(70, 3), cb = Generic(70, 3, 0, S21Layout::kColMajor);
+  EXPECT_TRUE(S21LU<double>(ca).Solve(cb).EqMatrix(S21LU<double>(a).Solve(b)));
+  S21Matrix spd(70, 70);
+  S21Matrix::Gemm(1, a, false, a, true, 0, spd);
+  S21Matrix cspd(spd);
+  cspd.SetLayout(S21Layout::kColMajor);
+  EXPECT_TRUE(S21Cholesky<double>(cspd).L().EqMatrix(
+      S21Cholesky<double>(spd).L(), S21Tolerance<double>::Norm(1e-12)));
+  S21Matrix r = Generic(9, 5), cr = Generic(9, 5, 0, S21Layout::kColMajor);
+  EXPECT_TRUE(S21QR<double>(cr).R().EqMatrix(S21QR<double>(r).R()));
+  for (S21Matrix m : {cr, cr.Transpose()})
+    EXPECT_TRUE(S21SVD<double>(m).Values().EqMatrix(
+        S21SVD<double>(r).Values(), S21Tolerance<double>::Relative(1e-12)));
+  EXPECT_TRUE(S21MatrixF(ca) == S21MatrixF(a));
+}
+
+TEST(Test, Tuning1) {
+  const S21TuningProfile saved = S21Tuning::Get();
+  S21Matrix a = Generic(40, 40), b = Generic(40, 23);
+  S21Matrix spd(40, 40);
+  S21Matrix::Gemm(1, a, false, a, true, 0, spd);
+  const S21Matrix ab = a * b, x = S21LU<double>(a).Solve(b);
+  const S21Matrix l = S21Cholesky<double>(spd).L();
+  const double dot = b.Dot(b);
+
+  S21TuningProfile odd;
+  odd.gemm_block = 7;
+  odd.transpose_block = 3;
+  odd.factor_block = 5;
+  odd.parallel_grain = 50;
+  S21Tuning::Set(odd);
+  EXPECT_TRUE(S21Tuning::Get() == odd);
+  EXPECT_TRUE((a * b).EqMatrix(ab));
+  EXPECT_TRUE(S21LU<double>(a).Solve(b).EqMatrix(x));
+  EXPECT_TRUE(S21Cholesky<double>(spd).L().EqMatrix(l));
+  EXPECT_NEAR(b.Dot(b), dot, 1e-12 * dot);
+  S21Matrix cb(b);
+  cb.SetLayout(S21Layout::kColMajor);
+  EXPECT_TRUE(cb == b);
+
+  S21Tuning::Save("s21_tuning_test.profile");
+  S21Tuning::Set(saved);
+  EXPECT_TRUE(S21Tuning::Load("s21_tuning_test.profile"));
+  EXPECT_TRUE(S21Tuning::Get() == odd);
+  S21Tuning::Set(saved);
+  std::remove("s21_tuning_test.profile");
+}
+
+TEST(Test, Tuning2) {
+  const S21TuningProfile saved = S21Tuning::Get();
+  {
+    std::ofstream out("s21_tuning_test.profile");
+    out << "# host profile\n"
+        << "gemm_block = 48  # tuned\n"
+        << "transpose_block = -4\n"
+        << "factor_block = 12x\n"
+        << "parallel_grain\n"
+        << "unknown = 9\n";
+  }
+  EXPECT_TRUE(S21Tuning::Load("s21_tuning_test.profile"));
+  S21TuningProfile expected = saved;
+  expected.gemm_block = 48;
+  EXPECT_TRUE(S21Tuning::Get() == expected);
+  EXPECT_FALSE(S21Tuning::Load("s21_missing.profile"));
+  EXPECT_TRUE(S21Tuning::Get() == expected);
+  S21TuningProfile bad;
+  bad.factor_block = 0;
+  EXPECT_THROW(S21Tuning::Set(bad), std::out_of_range);
+  EXPECT_TRUE(S21Tuning::Get() == expected);
+  S21Tuning::Set(saved);
+  std::remove("s21_tuning_test.profile");
+}
+
+TEST(Test, Determinism1) {
+  const S21Matrix a = Generic(700, 300), b = Generic(300, 200);
+  S21Matrix sq = Generic(150, 150);
+  const S21Tolerance<double> exact = S21Tolerance<double>::Absolute(0);
+  const S21TuningProfile saved = S21Tuning::Get();
+  EXPECT_EQ(S21Runtime::Determinism(), S21Determinism::kReproducible);
+  S21Runtime::SetThreads(1);
+  const S21Matrix ab = S21Matrix(a) * b;
+  const double det = sq.Determinant(), dot = a.Dot(a), fro = a.Norm();
+  const double one = a.Norm(S21Norm::kOne);
+
+  S21Runtime::SetThreads(4);
+  S21TuningProfile other = saved;
+  other.gemm_block = 24;
+  other.factor_block = 40;
+  other.parallel_grain = 1000;
+  S21Tuning::Set(other);
+  EXPECT_TRUE((S21Matrix(a) * b).EqMatrix(ab, exact));
+  EXPECT_EQ(sq.Determinant(), det);
+  EXPECT_EQ(a.Dot(a), dot);
+  EXPECT_EQ(a.Norm(), fro);
+  EXPECT_EQ(a.Norm(S21Norm::kOne), one);
+  {
+    S21DeterminismScope fast(S21Determinism::kFast);
+    EXPECT_EQ(S21Runtime::Determinism(), S21Determinism::kFast);
+    EXPECT_TRUE((S21Matrix(a) * b).EqMatrix(ab, exact));
+    EXPECT_EQ(sq.Determinant(), det);
+    EXPECT_NEAR(a.Dot(a), dot, 1e-12 * dot);
+    EXPECT_NEAR(a.Norm(), fro, 1e-12 * fro);
+    EXPECT_NEAR(a.Norm(S21Norm::kOne), one, 1e-12 * one);
+  }
+  EXPECT_EQ(S21Runtime::Determinism(), S21Determinism::kReproducible);
+
+  S21Runtime::SetDeterminism(S21Determinism::kFast);
+  EXPECT_EQ(S21Runtime::Determinism(), S21Determinism::kFast);
+  {
+    S21DeterminismScope reproducible(S21Determinism::kReproducible);
+    EXPECT_EQ(a.Dot(a), dot);
+    EXPECT_EQ(a.ColSums()(0, 7), S21Matrix(a).ColSums()(0, 7));
+  }
+  S21Runtime::SetDeterminism(S21Determinism::kReproducible);
+  S21Tuning::Set(saved);
+  S21Runtime::SetThreads(0);
+}
+
+TEST(Test, Rank1) {
+  S21Matrix a = Generic(30, 5) * Generic(5, 40);
+  EXPECT_EQ(a.Rank(), 5);
+  EXPECT_EQ(a.Transpose().Rank(), 5);
+  EXPECT_EQ(Generic(20, 20).Rank(), 20);
+  EXPECT_EQ(S21Matrix(4, 6).Rank(), 0);
+  S21Matrix n = a.NullSpace();
+  EXPECT_EQ(n.GetRows(), 40);
+  EXPECT_EQ(n.GetCols(), 35);
+  S21Matrix gram(35, 35), zero(30, 35);
+  S21Matrix::Gemm(1, n, true, n, false, 0, gram);
+  S21Matrix identity(35, 35);
+  for (int i = 0; i < 35; i++) identity(i, i) = 1;
+  EXPECT_TRUE(gram.EqMatrix(identity, S21Tolerance<double>::Absolute(1e-12)));
+  EXPECT_TRUE((a * n).EqMatrix(zero, S21Tolerance<double>::Absolute(1e-12)));
+  EXPECT_THROW(Generic(5, 5).NullSpace(), std::logic_error);
+  S21MatrixF f(a);
+  EXPECT_EQ(f.Rank(), 5);
+}
+
+TEST(Test, Rank2) {
+  S21Matrix d(3, 3);
+  d(0, 0) = 1;
+  d(1, 1) = 1e-8;
+  d(2, 2) = 2;
+  EXPECT_EQ(d.Rank(), 3);
+  EXPECT_EQ(d.Rank(1e-6), 2);
+  EXPECT_FALSE(d.IsSingular());
+  EXPECT_TRUE(d.IsSingular(1e-6));
+  S21Matrix n = d.NullSpace(1e-6);
+  EXPECT_NEAR(std::abs(n(1, 0)), 1, 1e-15);
+  EXPECT_FALSE(Generic(30, 30).IsSingular());
+  S21Matrix dup = Generic(30, 30);
+  for (int j = 0; j < 30; j++) dup(7, j) = dup(3, j) + 2 * dup(12, j);
+  EXPECT_TRUE(dup.IsSingular());
+  EXPECT_TRUE(dup.Transpose().IsSingular());
+  S21Matrix holes = Generic(30, 30);
+  for (int i = 0; i < 30; i++) holes(i, 4) = 0;
+  EXPECT_TRUE(holes.IsSingular());
+  EXPECT_THROW(S21Matrix(2, 3).IsSingular(), std::logic_error);
+}
+
+TEST(Test, LargeBuffers1) {
+  S21Runtime::SetThreads(4);
+  S21Matrix a(600, 600);
+  EXPECT_DOUBLE_EQ(a.Norm(S21Norm::kMax), 0);
+  S21Matrix b(600, 600, S21Matrix::kUninitialized);
+  for (int i = 0; i < 600; i++)
+    for (int j = 0; j < 600; j++) b(i, j) = i - j;
+  S21Matrix c(b);
+  EXPECT_TRUE(c == b);
+  c.SetCopyOnWrite(true);
+  S21Matrix d(c);
+  d(1, 2) = 7;
+  EXPECT_DOUBLE_EQ(c(1, 2), -1);
+  c.SetRows(1000);
+  EXPECT_DOUBLE_EQ(c(599, 0), 599);
+  EXPECT_DOUBLE_EQ(c(999, 599), 0);
+  c.AppendRow(S21Matrix(1, 600));
+  EXPECT_EQ(c.GetRows(), 1001);
+  S21Matrix small(2, 2, S21Matrix::kUninitialized);
+  small(0, 0) = small(0, 1) = small(1, 0) = small(1, 1) = 1;
+  EXPECT_DOUBLE_EQ(small.Determinant(), 0);
+  EXPECT_THROW(S21Matrix(0, 2, S21Matrix::kUninitialized), std::length_error);
+  S21Runtime::SetThreads(0);
+}
+
+TEST(Test, Construct1) {
+  S21Matrix a(3, 4, 2.5);
+  EXPECT_DOUBLE_EQ(a.Min(), 2.5);
+  EXPECT_DOUBLE_EQ(a.Max(), 2.5);
+  S21MatrixF f(2, 2, 1);
+  EXPECT_FLOAT_EQ(f.Trace(), 2);
+  S21Matrix big(600, 600, -1.0);
+  EXPECT_DOUBLE_EQ(big.Dot(big), 360000);
+  S21Matrix id = S21Matrix::Identity(4);
+  EXPECT_DOUBLE_EQ(id.Trace(), 4);
+  EXPECT_DOUBLE_EQ(id.Norm(), 2);
+  EXPECT_TRUE((Generic(4, 4) * id).EqMatrix(Generic(4, 4)));
+  EXPECT_TRUE(Generic(4, 4).Power(0) == id);
+  S21Matrix u(4, 4, S21Matrix::kUninitialized);
+  u = Generic(4, 4);
+  EXPECT_TRUE(u == Generic(4, 4));
+  S21Matrix d;
+  S21Matrix& r = (d = a);
+  EXPECT_EQ(&r, &d);
+  EXPECT_TRUE(d == a);
+  EXPECT_THROW(S21Matrix(0, 1, 1.0), std::length_error);
+  EXPECT_THROW(S21Matrix::Identity(0), std::length_error);
+}
+
+TEST(Test, SharedReaders1) {
+  S21Runtime::SetThreads(4);
+  S21Matrix shared = Generic(24, 24);
+  shared.SetCopyOnWrite(true);
+  const S21Matrix& a = shared;
+  const S21Matrix b = Generic(24, 24), small = Generic(5, 5);
+  const S21Matrix big = Generic(200, 200);
+  const double det = a.Determinant(), norm = big.Norm();
+  const S21Matrix inv = a.InverseMatrix(), comp = small.CalcComplements();
+  const S21Matrix prod = a * b, sums = big.RowSums();
+  const auto exact = S21Tolerance<double>::Ulp(0);
+  std::atomic<int> errors{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++)
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 20; i++) {
+        errors += a.Determinant() != det;
+        errors += !a.InverseMatrix().EqMatrix(inv, exact);
+        errors += !small.CalcComplements().EqMatrix(comp);
+        errors += !(a * b).EqMatrix(prod, exact);
+        errors += a.Transpose()(t, 0) != a(0, t);
+        errors += big.Norm() != norm || !(big.RowSums() == sums);
+        S21Matrix copy(a);
+        copy(t, t) += 1;
+        errors += copy(t, t) == a(t, t);
+      }
+    });
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(errors, 0);
+  EXPECT_FALSE(a.IsShared());
+  S21Runtime::SetThreads(0);
+}
+
+TEST(Test, Incremental1) {
+  S21Matrix a = Generic(30, 30);
+  for (int i = 0; i < 30; i++) a(i, i) += 10;
+  S21IncrementalInverse<double> inc(a);
+  const auto close = S21Tolerance<double>::Norm(1e-9);
+  for (int step = 0; step < 40; step++) {
+    const int k = step % 4 + 1;
+    const S21Matrix u = Generic(30, k), v = Generic(30, k) * 0.1;
+    if (step % 3) {
+      inc.Update(u, v);
+      a += u * v.Transpose();
+    } else {
+      inc.Downdate(u, v);
+      a -= u * v.Transpose();
+    }
+    EXPECT_TRUE(inc.A().EqMatrix(a, close));
+    EXPECT_TRUE(inc.Inverse().EqMatrix(a.InverseMatrix(), close));
+    EXPECT_NEAR(inc.Determinant() / a.Determinant(), 1, 1e-9);
+  }
+  EXPECT_EQ(inc.Refactorizations(), 1);
+  EXPECT_THROW(inc.Update(Generic(29, 1), Generic(30, 1)), std::logic_error);
+  EXPECT_THROW(inc.Update(Generic(30, 2), Generic(30, 1)), std::logic_error);
+  EXPECT_THROW(S21IncrementalInverse<double>(Generic(2, 3)),
+               std::logic_error);
+  EXPECT_THROW(S21IncrementalInverse<double>(a, -1, 0), std::out_of_range);
+}
+
+TEST(Test, Incremental2) {
+  S21IncrementalInverse<double> inc(S21Matrix::Identity(3));
+  S21Matrix e0(3, 1);
+  e0(0, 0) = 1;
+  inc.Downdate(e0, e0);
+  EXPECT_TRUE(inc.IsSingular());
+  EXPECT_DOUBLE_EQ(inc.Determinant(), 0);
+  EXPECT_THROW(inc.Inverse(), std::logic_error);
+  inc.Update(e0, e0 * 2);
+  EXPECT_FALSE(inc.IsSingular());
+  EXPECT_DOUBLE_EQ(inc.Determinant(), 2);
+  EXPECT_DOUBLE_EQ(inc.Inverse()(0, 0), 0.5);
+  // A zero tolerance fails every drift check.
+  S21IncrementalInverse<double> strict(Generic(10, 10), 0, 4);
+  for (int i = 0; i < 10; i++) strict.Update(Generic(10, 1), Generic(10, 1));
+  EXPECT_EQ(strict.Refactorizations(), 3);
+  S21IncrementalInverse<float> f(S21MatrixF::Identity(2));
+  f.Update(S21MatrixF(2, 1, 1), S21MatrixF(2, 1, 1));
+  EXPECT_FLOAT_EQ(f.Determinant(), 3);
+}
+
+TEST(Test, GemmAllocations) {
+  S21Runtime::SetThreads(8);
+  const S21Matrix a = Generic(300, 300), b = Generic(300, 300);
+  S21Matrix c(300, 300);
+  S21Matrix::Gemm(1, a, false, b, false, 0, c);
+  const long before = allocations;
+  for (int i = 0; i < 10; i++) S21Matrix::Gemm(1, a, false, b, false, 0, c);
+  EXPECT_EQ(allocations - before, 0);
+  const S21Matrix scaled = a * 0.05;
+  long start = allocations;
+  scaled.Power(3);
+  const long few = allocations - start;
+  start = allocations;
+  scaled.Power(1023);
+  EXPECT_EQ(allocations - start, few);
+  S21Runtime::SetThreads(0);
+}
+
 int main(int argc, char *argv[]) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
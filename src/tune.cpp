@@ -0,0 +1,129 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_tasks.h"
+#include "s21_matrix_tuning.h"
+
+// Cache sizes in bytes as reported by Linux sysfs, 0 where unknown.
+struct Caches {
+  long l1 = 0;
+  long l2 = 0;
+  long l3 = 0;
+};
+
+Caches ProbeCaches() {
+  Caches caches;
+  for (int index = 0;; index++) {
+    const std::string dir =
+        "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index);
+    std::ifstream level_file(dir + "/level"), type_file(dir + "/type"),
+        size_file(dir + "/size");
+    int level = 0;
+    std::string type, size;
+    if (!(level_file >> level && type_file >> type && size_file >> size))
+      break;
+    if (type == "Instruction") continue;
+    long bytes = std::atol(size.c_str());
+    if (size.back() == 'K') bytes <<= 10;
+    if (size.back() == 'M') bytes <<= 20;
+    if (level == 1) caches.l1 = bytes;
+    if (level == 2) caches.l2 = bytes;
+    if (level == 3) caches.l3 = bytes;
+  }
+  return caches;
+}
+
+template <typename F>
+double BestSeconds(F&& f) {
+  double best = 0;
+  for (int run = 0; run < 3; run++) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (run == 0 || elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+S21Matrix Random(int rows, int cols, std::mt19937& gen) {
+  std::uniform_real_distribution<double> dist(-1, 1);
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) m(i, j) = dist(gen);
+  return m;
+}
+
+// Times `run` with each candidate stored in `field` and keeps the fastest.
+// Candidates whose working set (`bytes` of one) exceeds `limit` are skipped
+// when the cache size is known.
+template <typename Run>
+void Tune(const char* name, int S21TuningProfile::*field,
+          const std::vector<int>& candidates, long bytes, long limit,
+          Run run) {
+  S21TuningProfile profile = S21Tuning::Get();
+  int best_value = profile.*field;
+  double best = -1;
+  std::printf("%s\n", name);
+  for (int value : candidates) {
+    if (limit > 0 && bytes * value * value > limit) continue;
+    profile.*field = value;
+    S21Tuning::Set(profile);
+    const double seconds = BestSeconds(run);
+    std::printf("%10d %10.4f\n", value, seconds);
+    if (best < 0 || seconds < best) {
+      best = seconds;
+      best_value = value;
+    }
+  }
+  profile.*field = best_value;
+  S21Tuning::Set(profile);
+}
+
+int main(int argc, char* argv[]) {
+  const std::string path = argc > 1 ? argv[1] : "s21_matrix.profile";
+  const int n = argc > 2 ? std::atoi(argv[2]) : 512;
+  const Caches caches = ProbeCaches();
+  std::printf("L1d %ld KiB, L2 %ld KiB, L3 %ld KiB\n\n", caches.l1 >> 10,
+              caches.l2 >> 10, caches.l3 >> 10);
+  std::mt19937 gen(21);
+  S21Matrix a = Random(n, n, gen), b = Random(n, n, gen), c(n, n);
+  S21Matrix mid = Random(2 * n, 2 * n, gen), big = Random(4 * n, 4 * n, gen);
+
+  // A Gemm tile of B should stay in half of L2 next to the streamed rows.
+  Tune("gemm_block", &S21TuningProfile::gemm_block,
+       {16, 32, 48, 64, 96, 128, 192, 256}, sizeof(double), caches.l2 / 2,
+       [&] { S21Matrix::Gemm(1, a, false, b, false, 0, c); });
+  // Source and destination tiles of a layout change share L1.
+  Tune("transpose_block", &S21TuningProfile::transpose_block,
+       {8, 16, 32, 64, 128}, 2 * sizeof(double), caches.l1, [&] {
+         big.SetLayout(S21Layout::kColMajor);
+         big.SetLayout(S21Layout::kRowMajor);
+       });
+  // The diagonal block of a panel is reused by every tile update.
+  Tune("factor_block", &S21TuningProfile::factor_block,
+       {32, 48, 64, 96, 128, 192, 256}, sizeof(double), caches.l2,
+       [&] { S21LU<double> lu(mid); });
+  // Only fast reductions and row loops follow the tuned grain.
+  S21DeterminismScope fast(S21Determinism::kFast);
+  Tune("parallel_grain", &S21TuningProfile::parallel_grain,
+       {1 << 12, 1 << 13, 1 << 14, 1 << 15, 1 << 16, 1 << 17, 1 << 18}, 0, 0,
+       [&] {
+         for (int i = 0; i < 4; i++) big.RowSums(), big.Dot(big);
+       });
+
+  S21Tuning::Save(path);
+  const S21TuningProfile best = S21Tuning::Get();
+  std::printf(
+      "\nwrote %s: gemm_block %d, transpose_block %d, factor_block %d, "
+      "parallel_grain %d\n",
+      path.c_str(), best.gemm_block, best.transpose_block, best.factor_block,
+      best.parallel_grain);
+  return 0;
+}